@@ -0,0 +1,193 @@
+#include "BenchLayer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <engine/Application.h>
+#include <engine/Log.h>
+#include <engine/ecs/Components.h>
+#include <engine/resources/MaterialManager.h>
+#include <engine/resources/MeshManager.h>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr float kSpacing = 2.0f;
+
+const char* GetSceneName(BenchScene scene) {
+    switch (scene) {
+    case BenchScene::Cubes:
+        return "cubes";
+    case BenchScene::Spheres:
+        return "spheres";
+    default:
+        return "mixed";
+    }
+}
+
+// Peak resident set size in bytes (0 where getrusage isn't available)
+uint64_t GetPeakResidentBytes() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss); // Bytes on macOS
+#    else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // Kilobytes on Linux
+#    endif
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+BenchLayer::BenchLayer(const BenchConfig& config)
+    : Layer("BenchLayer"), config_(config), sampler_(config.WarmupFrames, config.Frames) {}
+
+void BenchLayer::OnAttach() {
+    LoadMaterials();
+    se::MeshManager::PreloadPrimitives({se::PrimitiveMeshType::Cube,
+                                        se::PrimitiveMeshType::Sphere});
+    BuildScene();
+
+    // Look down at the grid from outside its corner so every entity is in view
+    float side = std::ceil(std::sqrt(static_cast<float>(config_.Entities))) * kSpacing;
+    camera_ = Camera(glm::vec3(0.0f, side * 0.5f + 5.0f, side * 0.5f + 10.0f),
+                     glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, -40.0f);
+
+    se::RenderCommand::SetClearColor({0.3f, 0.3f, 0.3f, 1.0f});
+}
+
+void BenchLayer::OnDetach() {
+    scene_.reset();
+    materials_.clear();
+}
+
+void BenchLayer::LoadMaterials() {
+    auto assetsFolder = findAssetsFolder();
+    if (!assetsFolder) {
+        SE_LOG_ERROR("Assets folder not found; run from the repository root or set ASSETS_DIR");
+        return;
+    }
+    fs::path vertexPath = assetsFolder.value() / "shaders" / "basic.vert";
+    fs::path fragmentPath = assetsFolder.value() / "shaders" / "basic.frag";
+    std::shared_ptr<se::Shader> shader =
+        se::MaterialManager::GetShader("DefaultShader", vertexPath, fragmentPath);
+
+    uint32_t count = std::max(config_.Materials, 1u);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto material = se::MaterialManager::CreateMaterial(shader);
+        material->SetFloat("uSpecularStrength", 0.1f + 0.8f * i / count);
+        materials_.push_back(material);
+    }
+}
+
+void BenchLayer::BuildScene() {
+    scene_ = std::make_unique<se::Scene>("Bench Scene");
+
+    auto sun = scene_->CreateEntity("Sun");
+    sun.GetComponent<se::TransformComponent>().SetRotation({100.0f, 0.0f, 0.0f});
+    auto& light = sun.AddComponent<se::DirectionalLightComponent>();
+    light.Intensity = 1.5f;
+    light.CastShadows = config_.Shadows;
+
+    auto cube = se::MeshManager::GetPrimitive(se::PrimitiveMeshType::Cube);
+    auto sphere = se::MeshManager::GetPrimitive(se::PrimitiveMeshType::Sphere);
+    if (!cube || !sphere || materials_.empty()) {
+        SE_LOG_ERROR("Bench scene resources missing");
+        return;
+    }
+
+    uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(float(config_.Entities))));
+    float origin = -0.5f * kSpacing * (columns - 1);
+    for (uint32_t i = 0; i < config_.Entities; ++i) {
+        bool isSphere = config_.Scene == BenchScene::Spheres ||
+                        (config_.Scene == BenchScene::Mixed && i % 2 == 1);
+        auto entity = scene_->CreateEntity(isSphere ? "Sphere" : "Cube");
+        entity.AddComponent<se::MeshRenderComponent>(isSphere ? sphere : cube,
+                                                     materials_[i % materials_.size()]);
+
+        auto& transform = entity.GetComponent<se::TransformComponent>();
+        transform.SetPosition({origin + (i % columns) * kSpacing, 0.0f,
+                               origin + (i / columns) * kSpacing});
+        transform.SetScale(glm::vec3(isSphere ? 1.0f : 0.8f));
+    }
+}
+
+void BenchLayer::OnFixedUpdate(float ts) {
+    scene_->OnFixedUpdate(ts);
+    if (!config_.Animated)
+        return;
+
+    auto view = scene_->GetAllEntitiesWith<se::TransformComponent, se::MeshRenderComponent>();
+    for (auto entity : view)
+        view.get<se::TransformComponent>(entity).Rotate({0.0f, 45.0f * ts, 0.0f});
+}
+
+void BenchLayer::OnUpdate(float ts) {
+    scene_->OnUpdate(ts);
+    if (done_)
+        return;
+
+    // The previous frame is complete by now
+    auto& app = se::Application::Get();
+    if (sampler_.Add(app.GetLastFrameRecord()) && sampler_.IsDone()) {
+        done_ = true;
+        WriteReport();
+        app.Stop();
+    }
+}
+
+void BenchLayer::OnRender() {
+    auto& window = se::Application::Get().GetWindow();
+    float aspectRatio = float(window.GetWidth()) / float(window.GetHeight());
+    scene_->OnRender(camera_, aspectRatio, se::Application::Get().GetInterpolationAlpha());
+}
+
+void BenchLayer::WriteReport() const {
+    const se::RenderStats& render = sampler_.GetLastRecord().Render;
+    se::PassCounters total = render.Counters.Total();
+    se::AllocationFrameStats allocations = se::AllocationTracker::GetTotals();
+    uint64_t allocated = allocations.Total().Count;
+    uint64_t live = allocated > allocations.Frees ? allocated - allocations.Frees : 0;
+
+    std::string out = "{\n";
+    fmt::format_to(std::back_inserter(out),
+                   "  \"config\": {{\"entities\": {}, \"scene\": \"{}\", \"materials\": {}, "
+                   "\"shadows\": {}, \"animated\": {}, \"warmup\": {}, \"frames\": {}, "
+                   "\"headless\": {}, \"renderThread\": {}}},\n",
+                   config_.Entities, GetSceneName(config_.Scene), materials_.size(),
+                   config_.Shadows, config_.Animated, config_.WarmupFrames, sampler_.GetCount(),
+                   config_.Headless, config_.RenderThread);
+    fmt::format_to(std::back_inserter(out), "  \"firstFrame\": {},\n",
+                   sampler_.GetFirstFrame());
+    sampler_.AppendJson(out);
+    fmt::format_to(std::back_inserter(out),
+                   "  \"lastFrame\": {{\"drawCalls\": {}, \"shadowDrawCalls\": {}, "
+                   "\"triangles\": {}, \"programBinds\": {}, \"textureBinds\": {}, "
+                   "\"uniformUploads\": {}, \"objectsSubmitted\": {}, \"entities\": {}}},\n",
+                   total.DrawCalls, render.Counters.Pass(se::GpuPass::Shadow).DrawCalls,
+                   total.Triangles, total.ProgramBinds, total.TextureBinds, total.UniformUploads,
+                   render.Counters.ObjectsSubmitted, render.Counters.Entities);
+    fmt::format_to(std::back_inserter(out),
+                   "  \"memory\": {{\"peakResidentBytes\": {}, \"liveAllocations\": {}, "
+                   "\"frameArenaPeakBytes\": {}}}\n}}\n",
+                   GetPeakResidentBytes(), live,
+                   se::Application::Get().GetFrameArena().GetStats().PeakBytes);
+
+    std::fputs(out.c_str(), stdout);
+    std::fflush(stdout);
+    if (config_.OutputPath.empty())
+        return;
+    if (std::FILE* file = std::fopen(config_.OutputPath.c_str(), "w")) {
+        std::fputs(out.c_str(), file);
+        std::fclose(file);
+    } else {
+        SE_LOG_ERROR("Failed to write bench report to '{}'", config_.OutputPath);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <engine/Camera.h>
+#include <engine/FrameStats.h>
+#include <engine/Layer.h>
+#include <engine/ecs/Scene.h>
+#include <engine/renderer/Material.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class BenchScene { Cubes, Spheres, Mixed };
+
+struct BenchConfig {
+    uint32_t Entities = 1000;
+    BenchScene Scene = BenchScene::Mixed;
+    // Distinct materials the entities cycle through (forces material switches)
+    uint32_t Materials = 8;
+    bool Shadows = true;
+    bool Animated = false;
+    uint32_t WarmupFrames = 60;
+    uint32_t Frames = 300;
+    bool Headless = false;
+    bool RenderThread = false;
+    // Also write the JSON report here
+    std::string OutputPath;
+};
+
+// Builds a grid of primitives, lets the engine run WarmupFrames + Frames frames, then prints
+// per-frame CPU/GPU time percentiles, render counters and memory as one JSON object and
+// stops the application.
+class BenchLayer : public se::Layer {
+  public:
+    explicit BenchLayer(const BenchConfig& config);
+
+    void OnAttach() override;
+    void OnDetach() override;
+    void OnFixedUpdate(float ts) override;
+    void OnUpdate(float ts) override;
+    void OnRender() override;
+
+  private:
+    void LoadMaterials();
+    void BuildScene();
+    void WriteReport() const;
+
+  private:
+    BenchConfig config_;
+    std::unique_ptr<se::Scene> scene_;
+    std::vector<std::shared_ptr<se::Material>> materials_;
+    Camera camera_;
+
+    se::FrameSampler sampler_;
+    bool done_ = false;
+};
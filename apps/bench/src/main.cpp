@@ -0,0 +1,72 @@
+#include "BenchLayer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <engine/Application.h>
+#include <engine/Log.h>
+
+int main(int argc, char** argv) {
+    BenchConfig config;
+
+    // --entities N: primitives in the grid (default 1000)
+    // --scene cubes|spheres|mixed: which primitives to spawn (default mixed)
+    // --materials N: materials the entities cycle through (default 8)
+    // --no-shadows: turn the shadow pass off
+    // --animated: rotate every entity each fixed step instead of keeping them static
+    // --warmup N / --frames N: frames skipped, then frames measured (default 60 / 300)
+    // --headless: offscreen run for CI
+    // --render-thread: submit from the dedicated render thread
+    // --output FILE: also write the JSON report to FILE
+    // --verbose: keep the engine's info logging
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--entities") == 0 && i + 1 < argc) {
+            config.Entities = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            const char* scene = argv[++i];
+            if (strcmp(scene, "cubes") == 0)
+                config.Scene = BenchScene::Cubes;
+            else if (strcmp(scene, "spheres") == 0)
+                config.Scene = BenchScene::Spheres;
+            else
+                config.Scene = BenchScene::Mixed;
+        } else if (strcmp(argv[i], "--materials") == 0 && i + 1 < argc) {
+            config.Materials = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--no-shadows") == 0) {
+            config.Shadows = false;
+        } else if (strcmp(argv[i], "--animated") == 0) {
+            config.Animated = true;
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.WarmupFrames = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            config.Frames = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            config.Headless = true;
+        } else if (strcmp(argv[i], "--render-thread") == 0) {
+            config.RenderThread = true;
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            config.OutputPath = argv[++i];
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        }
+    }
+
+    se::LogInit(false);
+    // The report goes to stdout; per-entity creation logs would bury it
+    if (!verbose)
+        se::Logger()->set_level(spdlog::level::warn);
+
+    se::ApplicationSpec appSpec;
+    appSpec.Name = "Simple Engine Bench";
+    appSpec.WindowWidth = 1920;
+    appSpec.WindowHeight = 1080;
+    // Measure the engine, not the display: no VSync, no frame cap, no hitch dumps
+    appSpec.VSync = false;
+    appSpec.FlightRecorder = false;
+    appSpec.Headless = config.Headless;
+    appSpec.RenderThread = config.RenderThread;
+
+    se::Application application(appSpec);
+    application.PushLayer<BenchLayer>(config);
+    application.Run();
+}
@@ -0,0 +1,125 @@
+#include "Microbench.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+namespace microbench {
+
+namespace {
+
+double TimeIterations(const Benchmark& benchmark, uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    benchmark.Run(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+} // namespace
+
+Result Run(const Benchmark& benchmark, const RunOptions& options) {
+    // Grow the iteration count until one repetition is long enough to time reliably
+    double minTimeNs = options.MinTimeMs * 1.0e6;
+    uint64_t iterations = 1;
+    for (;;) {
+        double elapsed = TimeIterations(benchmark, iterations);
+        if (elapsed >= minTimeNs)
+            break;
+        // Aim slightly past the target from the last measurement, at most 10x per step
+        double scale = elapsed > 0.0 ? std::min(10.0, 1.2 * minTimeNs / elapsed) : 10.0;
+        iterations = std::max<uint64_t>(iterations + 1, uint64_t(iterations * scale));
+    }
+
+    for (uint32_t i = 0; i < options.WarmupReps; ++i)
+        TimeIterations(benchmark, iterations);
+
+    std::vector<double> samples;
+    samples.reserve(options.Reps);
+    for (uint32_t i = 0; i < std::max(options.Reps, 1u); ++i)
+        samples.push_back(TimeIterations(benchmark, iterations) / iterations);
+
+    Result result;
+    result.Name = benchmark.Name;
+    result.Iterations = iterations;
+    result.Reps = static_cast<uint32_t>(samples.size());
+    result.MeanNs = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    double variance = 0.0;
+    for (double sample : samples)
+        variance += (sample - result.MeanNs) * (sample - result.MeanNs);
+    result.StdDevNs = samples.size() > 1 ? std::sqrt(variance / (samples.size() - 1)) : 0.0;
+
+    std::sort(samples.begin(), samples.end());
+    result.MinNs = samples.front();
+    result.MaxNs = samples.back();
+    size_t middle = samples.size() / 2;
+    result.MedianNs = samples.size() % 2 ? samples[middle]
+                                         : 0.5 * (samples[middle - 1] + samples[middle]);
+    return result;
+}
+
+void PrintHeader(Format format) {
+    switch (format) {
+    case Format::Table:
+        std::printf("%-44s %12s %12s %12s %8s %10s\n", "benchmark", "median ns", "min ns",
+                    "max ns", "cv %", "iters");
+        break;
+    case Format::Csv:
+        std::printf("name,iterations,reps,min_ns,median_ns,mean_ns,stddev_ns,max_ns\n");
+        break;
+    case Format::Json:
+        break;
+    }
+}
+
+void Print(const Result& result, Format format, double baselineMedianNs) {
+    double cv = result.MeanNs > 0.0 ? 100.0 * result.StdDevNs / result.MeanNs : 0.0;
+    switch (format) {
+    case Format::Table:
+        std::printf("%-44s %12.1f %12.1f %12.1f %8.2f %10llu", result.Name.c_str(),
+                    result.MedianNs, result.MinNs, result.MaxNs, cv,
+                    static_cast<unsigned long long>(result.Iterations));
+        if (baselineMedianNs > 0.0)
+            std::printf("  %+7.1f%% vs baseline",
+                        100.0 * (result.MedianNs - baselineMedianNs) / baselineMedianNs);
+        std::printf("\n");
+        break;
+    case Format::Csv:
+        std::printf("%s,%llu,%u,%.2f,%.2f,%.2f,%.2f,%.2f\n", result.Name.c_str(),
+                    static_cast<unsigned long long>(result.Iterations), result.Reps,
+                    result.MinNs, result.MedianNs, result.MeanNs, result.StdDevNs,
+                    result.MaxNs);
+        break;
+    case Format::Json:
+        std::printf("{\"name\":\"%s\",\"iterations\":%llu,\"reps\":%u,\"min_ns\":%.2f,"
+                    "\"median_ns\":%.2f,\"mean_ns\":%.2f,\"stddev_ns\":%.2f,\"max_ns\":%.2f}\n",
+                    result.Name.c_str(), static_cast<unsigned long long>(result.Iterations),
+                    result.Reps, result.MinNs, result.MedianNs, result.MeanNs,
+                    result.StdDevNs, result.MaxNs);
+        break;
+    }
+    std::fflush(stdout);
+}
+
+std::vector<std::pair<std::string, double>> LoadBaseline(const std::string& path) {
+    std::vector<std::pair<std::string, double>> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        // name,iterations,reps,min_ns,median_ns,...
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        for (std::string field; std::getline(stream, field, ',');)
+            fields.push_back(field);
+        if (fields.size() < 5 || fields[0] == "name")
+            continue;
+        baseline.emplace_back(fields[0], std::atof(fields[4].c_str()));
+    }
+    return baseline;
+}
+
+} // namespace microbench
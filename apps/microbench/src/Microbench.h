@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness: each benchmark is a function running its operation
+// `iterations` times. The harness calibrates the iteration count so one repetition takes
+// at least MinTimeMs, runs WarmupReps discarded repetitions, then Reps measured ones, and
+// reports nanoseconds per operation over the repetitions.
+namespace microbench {
+
+// Keeps the compiler from discarding a value whose computation is being measured
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+using BenchmarkFn = std::function<void(uint64_t iterations)>;
+
+struct Benchmark {
+    std::string Name;
+    BenchmarkFn Run;
+};
+
+struct RunOptions {
+    double MinTimeMs = 20.0;
+    uint32_t WarmupReps = 2;
+    uint32_t Reps = 15;
+};
+
+// Nanoseconds per operation, over the measured repetitions
+struct Result {
+    std::string Name;
+    uint64_t Iterations = 0; // Per repetition
+    uint32_t Reps = 0;
+    double MinNs = 0.0;
+    double MedianNs = 0.0;
+    double MeanNs = 0.0;
+    double StdDevNs = 0.0;
+    double MaxNs = 0.0;
+};
+
+Result Run(const Benchmark& benchmark, const RunOptions& options);
+
+enum class Format { Table, Csv, Json };
+
+// One line per result. Csv and Json (one object per line) have a fixed column order, so
+// runs from two commits diff cleanly.
+void PrintHeader(Format format);
+void Print(const Result& result, Format format, double baselineMedianNs = 0.0);
+
+// Median ns/op per benchmark name from an earlier --format csv run (empty on failure)
+std::vector<std::pair<std::string, double>> LoadBaseline(const std::string& path);
+
+} // namespace microbench
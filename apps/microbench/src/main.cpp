@@ -0,0 +1,293 @@
+#include "Microbench.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <engine/Log.h>
+#include <engine/MeshFactory.h>
+#include <engine/ecs/Components.h>
+#include <engine/ecs/Scene.h>
+#include <engine/renderer/Buffer.h>
+#include <engine/renderer/Material.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using microbench::Benchmark;
+using microbench::DoNotOptimize;
+
+namespace {
+
+constexpr size_t kTransformCount = 1024;
+constexpr uint32_t kSceneEntities = 10000;
+
+std::vector<se::TransformComponent> MakeTransforms() {
+    std::vector<se::TransformComponent> transforms(kTransformCount);
+    for (size_t i = 0; i < transforms.size(); ++i) {
+        float f = static_cast<float>(i);
+        transforms[i].SetPosition({f, f * 0.5f, -f});
+        transforms[i].SetRotation({f * 3.0f, f * 7.0f, f * 11.0f});
+        transforms[i].SetScale(glm::vec3(1.0f + 0.001f * f));
+    }
+    return transforms;
+}
+
+// A tessellated grid of pos+color vertices, the input addNormals expects
+struct GridMesh {
+    std::vector<float> Vertices;
+    std::vector<unsigned int> Indices;
+};
+
+GridMesh MakeGrid(unsigned int size) {
+    GridMesh grid;
+    for (unsigned int y = 0; y <= size; ++y) {
+        for (unsigned int x = 0; x <= size; ++x) {
+            float height = 0.1f * static_cast<float>((x * 7 + y * 13) % 5);
+            grid.Vertices.insert(grid.Vertices.end(),
+                                 {float(x), height, float(y), 1.0f, 1.0f, 1.0f});
+        }
+    }
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            unsigned int i = y * (size + 1) + x;
+            grid.Indices.insert(grid.Indices.end(),
+                                {i, i + size + 1, i + 1, i + 1, i + size + 1, i + size + 2});
+        }
+    }
+    return grid;
+}
+
+// Entities laid out like a game scene: every one has a mesh component, and the fixed step
+// has given them a PreviousTransformComponent
+std::unique_ptr<se::Scene> MakeScene(uint32_t entities) {
+    auto scene = std::make_unique<se::Scene>("Microbench");
+    auto material = std::make_shared<se::Material>(nullptr);
+    for (uint32_t i = 0; i < entities; ++i) {
+        auto entity = scene->CreateEntity("Entity_" + std::to_string(i));
+        auto& transform = entity.GetComponent<se::TransformComponent>();
+        transform.SetPosition({float(i % 100), 0.0f, float(i / 100)});
+        transform.SetRotation({0.0f, float(i), 0.0f});
+        entity.AddComponent<se::MeshRenderComponent>(nullptr, material);
+    }
+    scene->OnFixedUpdate(1.0f / 60.0f);
+    return scene;
+}
+
+// The entity walk of RenderSystem::Render without the GL side: same view, component
+// lookups and transform math, with the matrices summed instead of submitted
+float WalkRenderView(se::Scene& scene) {
+    float sum = 0.0f;
+    auto view = scene.GetAllEntitiesWith<se::TransformComponent, se::MeshRenderComponent>();
+    for (auto entity : view) {
+        auto& transform = view.get<se::TransformComponent>(entity);
+        auto& meshRender = view.get<se::MeshRenderComponent>(entity);
+        if (!meshRender.IsVisible || !meshRender.Material)
+            continue;
+        sum += transform.GetTransform()[3][0];
+    }
+    return sum;
+}
+
+// The interpolating variant. RenderSystem looks the previous transform up with try_get;
+// Scene doesn't expose its registry, so this joins it into the view instead.
+float WalkRenderViewInterpolated(se::Scene& scene, float alpha) {
+    float sum = 0.0f;
+    auto view = scene.GetAllEntitiesWith<se::TransformComponent, se::MeshRenderComponent,
+                                         se::PreviousTransformComponent>();
+    for (auto entity : view) {
+        auto& transform = view.get<se::TransformComponent>(entity);
+        auto& meshRender = view.get<se::MeshRenderComponent>(entity);
+        if (!meshRender.IsVisible || !meshRender.Material)
+            continue;
+        const auto& previous = view.get<se::PreviousTransformComponent>(entity);
+        sum += previous.Interpolate(transform, alpha)[3][0];
+    }
+    return sum;
+}
+
+std::vector<Benchmark> MakeBenchmarks() {
+    std::vector<Benchmark> benchmarks;
+
+    auto transforms = std::make_shared<std::vector<se::TransformComponent>>(MakeTransforms());
+    benchmarks.push_back({"TransformComponent::GetTransform", [transforms](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i)
+                                  DoNotOptimize((*transforms)[i % kTransformCount].GetTransform());
+                          }});
+    benchmarks.push_back(
+        {"PreviousTransformComponent::Interpolate", [transforms](uint64_t n) {
+             se::PreviousTransformComponent previous((*transforms)[0]);
+             for (uint64_t i = 0; i < n; ++i)
+                 DoNotOptimize(previous.Interpolate((*transforms)[i % kTransformCount], 0.5f));
+         }});
+
+    // addNormals works in place, so every call starts from a fresh copy of the input;
+    // the copy is timed separately to subtract it
+    auto grid = std::make_shared<GridMesh>(MakeGrid(256));
+    benchmarks.push_back({"MeshFactory::addNormals input copy 256x256", [grid](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::vector<float> vertices = grid->Vertices;
+                                  DoNotOptimize(vertices.data());
+                              }
+                          }});
+    benchmarks.push_back({"MeshFactory::addNormals 256x256", [grid](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::vector<float> vertices = grid->Vertices;
+                                  MeshFactory::addNormals(vertices, grid->Indices);
+                                  DoNotOptimize(vertices.data());
+                              }
+                          }});
+
+    auto addMesh = [&](const char* name, auto create) {
+        benchmarks.push_back({name, [create](uint64_t n) {
+                                  for (uint64_t i = 0; i < n; ++i) {
+                                      Mesh mesh = create();
+                                      DoNotOptimize(mesh.getVertices().data());
+                                  }
+                              }});
+    };
+    addMesh("MeshFactory::CreateTriangle", [] { return MeshFactory::CreateTriangle(); });
+    addMesh("MeshFactory::CreateQuad", [] { return MeshFactory::CreateQuad(); });
+    addMesh("MeshFactory::CreateCube", [] { return MeshFactory::CreateCube(); });
+    addMesh("MeshFactory::CreateSphere 32x16", [] { return MeshFactory::CreateSphere(); });
+    addMesh("MeshFactory::CreateSphere 256x128",
+            [] { return MeshFactory::CreateSphere(256, 128); });
+    addMesh("MeshFactory::CreateCapsule 256",
+            [] { return MeshFactory::CreateCapsule(0.5f, 1.0f, 256); });
+    addMesh("MeshFactory::CreateCylinder 256",
+            [] { return MeshFactory::CreateCylinder(0.5f, 1.0f, 256); });
+
+    benchmarks.push_back({"BufferLayout pos+color+normal", [](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  se::BufferLayout layout(
+                                      {{se::ShaderDataType::Float3, "a_Position"},
+                                       {se::ShaderDataType::Float3, "a_Color"},
+                                       {se::ShaderDataType::Float3, "a_Normal"}});
+                                  DoNotOptimize(layout.GetStride());
+                              }
+                          }});
+
+    // Uniform storage only; Bind() needs a GL context
+    auto material = std::make_shared<se::Material>(nullptr);
+    material->SetFloat("uSpecularStrength", 0.5f);
+    material->SetMatrix4("uModel", glm::mat4(1.0f));
+    benchmarks.push_back({"Material::SetFloat existing", [material](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i)
+                                  material->SetFloat("uSpecularStrength", float(i & 7));
+                              DoNotOptimize(material.get());
+                          }});
+    benchmarks.push_back({"Material::SetMatrix4 existing", [material](uint64_t n) {
+                              glm::mat4 value(1.0f);
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  value[3][0] = float(i & 7);
+                                  material->SetMatrix4("uModel", value);
+                              }
+                              DoNotOptimize(material.get());
+                          }});
+    benchmarks.push_back({"Material create + 5 uniforms", [](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  se::Material created(nullptr);
+                                  created.SetFloat("uSpecularStrength", 0.5f);
+                                  created.SetFloat("uAmbientStrength", 0.1f);
+                                  created.SetInt("uShadowMap", 1);
+                                  created.SetVector3("uColor", glm::vec3(1.0f));
+                                  created.SetMatrix4("uModel", glm::mat4(1.0f));
+                                  DoNotOptimize(created);
+                              }
+                          }});
+
+    benchmarks.push_back({"Scene::CreateEntity x1000 (fresh scene)", [](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  se::Scene scene("CreateEntity");
+                                  for (int e = 0; e < 1000; ++e)
+                                      DoNotOptimize(scene.CreateEntity("Entity"));
+                              }
+                          }});
+
+    std::shared_ptr<se::Scene> scene = MakeScene(kSceneEntities);
+    // entt walks the newest entity first, so the first one created is the worst case
+    benchmarks.push_back({"Scene::FindEntityByName worst of 10k", [scene](uint64_t n) {
+                              const std::string name = "Entity_0";
+                              for (uint64_t i = 0; i < n; ++i)
+                                  DoNotOptimize(scene->FindEntityByName(name));
+                          }});
+    benchmarks.push_back({"RenderSystem view walk 10k", [scene](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i)
+                                  DoNotOptimize(WalkRenderView(*scene));
+                          }});
+    benchmarks.push_back({"RenderSystem view walk 10k interpolated", [scene](uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i)
+                                  DoNotOptimize(WalkRenderViewInterpolated(*scene, 0.5f));
+                          }});
+
+    return benchmarks;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // --filter TEXT: only run benchmarks whose name contains TEXT
+    // --format table|csv|json: output format (csv and json lines diff cleanly between runs)
+    // --baseline FILE: show the median change against an earlier --format csv run
+    // --reps N / --warmup N: measured and discarded repetitions (default 15 / 2)
+    // --min-time-ms X: minimum duration of one repetition (default 20)
+    // --list: print the benchmark names and exit
+    microbench::RunOptions options;
+    microbench::Format format = microbench::Format::Table;
+    std::string filter;
+    std::string baselinePath;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (strcmp(name, "csv") == 0)
+                format = microbench::Format::Csv;
+            else if (strcmp(name, "json") == 0)
+                format = microbench::Format::Json;
+            else
+                format = microbench::Format::Table;
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "--reps") == 0 && i + 1 < argc) {
+            options.Reps = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            options.WarmupReps = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            options.MinTimeMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list = true;
+        }
+    }
+
+    // Entity creation logs at info level; that cost stays in, the output doesn't
+    se::LogInit(false);
+    se::Logger()->set_level(spdlog::level::err);
+
+    std::vector<std::pair<std::string, double>> baseline;
+    if (!baselinePath.empty()) {
+        baseline = microbench::LoadBaseline(baselinePath);
+        if (baseline.empty())
+            std::fprintf(stderr, "No results in baseline '%s'\n", baselinePath.c_str());
+    }
+
+    std::vector<Benchmark> benchmarks = MakeBenchmarks();
+    if (list) {
+        for (const Benchmark& benchmark : benchmarks)
+            std::printf("%s\n", benchmark.Name.c_str());
+        return 0;
+    }
+
+    microbench::PrintHeader(format);
+    for (const Benchmark& benchmark : benchmarks) {
+        if (!filter.empty() && benchmark.Name.find(filter) == std::string::npos)
+            continue;
+
+        double baselineMedian = 0.0;
+        for (const auto& [name, median] : baseline) {
+            if (name == benchmark.Name)
+                baselineMedian = median;
+        }
+        microbench::Print(microbench::Run(benchmark, options), format, baselineMedian);
+    }
+    return 0;
+}
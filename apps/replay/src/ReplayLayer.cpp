@@ -0,0 +1,138 @@
+#include "ReplayLayer.h"
+#include <cstdio>
+#include <engine/Application.h>
+#include <engine/Log.h>
+#include <engine/renderer/RenderCommand.h>
+#include <engine/renderer/SceneRenderer.h>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+ReplayLayer::ReplayLayer(const ReplayConfig& config, se::CapturedFrame frame)
+    : Layer("ReplayLayer"), config_(config), frame_(std::move(frame)),
+      sampler_(config.WarmupFrames, config.Frames) {}
+
+void ReplayLayer::OnAttach() {
+    ready_ = CreateResources();
+    if (!ready_) {
+        se::Application::Get().Stop();
+        return;
+    }
+    se::RenderCommand::SetClearColor({0.3f, 0.3f, 0.3f, 1.0f});
+}
+
+void ReplayLayer::OnDetach() {
+    materials_.clear();
+    meshes_.clear();
+}
+
+bool ReplayLayer::CreateResources() {
+    std::vector<std::shared_ptr<se::Shader>> shaders;
+    for (const se::CapturedShader& source : frame_.Shaders) {
+        try {
+            shaders.push_back(
+                std::make_shared<se::Shader>(source.VertexSource, source.FragmentSource));
+        } catch (const std::exception& e) {
+            SE_LOG_ERROR("Captured shader {} failed to build: {}", shaders.size(), e.what());
+            return false;
+        }
+    }
+
+    for (const se::CapturedMaterial& captured : frame_.Materials) {
+        auto material = std::make_shared<se::Material>(shaders[captured.Shader]);
+        for (const auto& [name, value] : captured.Floats)
+            material->SetFloat(name, value);
+        for (const auto& [name, value] : captured.Ints)
+            material->SetInt(name, value);
+        for (const auto& [name, value] : captured.Vector3s)
+            material->SetVector3(name, value);
+        for (const auto& [name, value] : captured.Vector4s)
+            material->SetVector4(name, value);
+        for (const auto& [name, value] : captured.Matrix4s)
+            material->SetMatrix4(name, value);
+        materials_.push_back(std::move(material));
+    }
+
+    for (const se::CapturedMesh& captured : frame_.Meshes) {
+        auto vertexArray = std::make_shared<se::VertexArray>();
+        for (const se::CapturedVertexBuffer& buffer : captured.VertexBuffers) {
+            auto vertexBuffer = std::make_shared<se::VertexBuffer>(
+                buffer.Data.data(), static_cast<uint32_t>(buffer.Data.size()));
+            vertexBuffer->SetLayout(se::BufferLayout(buffer.Layout));
+            vertexArray->AddVertexBuffer(vertexBuffer);
+        }
+        vertexArray->SetIndexBuffer(std::make_shared<se::IndexBuffer>(
+            captured.Indices.data(), static_cast<uint32_t>(captured.Indices.size())));
+        meshes_.push_back(std::move(vertexArray));
+    }
+
+    SE_LOG_INFO("Replaying '{}': {} submissions, {} meshes, {} materials, {} shaders",
+                config_.CapturePath, frame_.Submissions.size(), meshes_.size(),
+                materials_.size(), shaders.size());
+    return true;
+}
+
+void ReplayLayer::OnUpdate(float) {
+    if (!ready_ || done_ || config_.Frames == 0)
+        return;
+
+    // The previous frame is complete by now
+    auto& app = se::Application::Get();
+    if (sampler_.Add(app.GetLastFrameRecord()) && sampler_.IsDone()) {
+        done_ = true;
+        WriteReport();
+        app.Stop();
+    }
+}
+
+void ReplayLayer::OnRender() {
+    if (!ready_)
+        return;
+
+    // Same call sequence as RenderSystem: the light first, BeginScene derives the shadow
+    // matrix from it
+    if (frame_.DirectionalLight.Active)
+        se::SceneRenderer::SetDirectionalLight(frame_.DirectionalLight);
+    else
+        se::SceneRenderer::ClearDirectionalLight();
+
+    se::SceneRenderer::BeginScene(frame_.ViewMatrix, frame_.ProjectionMatrix);
+    // Material-less submissions go in with a null material: shadow casters only
+    const std::shared_ptr<se::Material> noMaterial;
+    for (const se::CapturedSubmission& submission : frame_.Submissions) {
+        const std::shared_ptr<se::Material>& material =
+            submission.Material == se::CapturedSubmission::kNoMaterial
+                ? noMaterial
+                : materials_[submission.Material];
+        se::SceneRenderer::Submit(meshes_[submission.Mesh], material, submission.Transform,
+                                  submission.CastsShadows, submission.ReceiveShadows);
+    }
+    se::SceneRenderer::EndScene();
+}
+
+void ReplayLayer::WriteReport() const {
+    const se::RenderStats& render = sampler_.GetLastRecord().Render;
+    se::PassCounters total = render.Counters.Total();
+
+    std::string out = "{\n";
+    fmt::format_to(std::back_inserter(out),
+                   "  \"capture\": {{\"path\": \"{}\", \"submissions\": {}, \"meshes\": {}, "
+                   "\"materials\": {}, \"shaders\": {}, \"viewport\": [{}, {}]}},\n",
+                   config_.CapturePath, frame_.Submissions.size(), frame_.Meshes.size(),
+                   frame_.Materials.size(), frame_.Shaders.size(), frame_.ViewportSize.x,
+                   frame_.ViewportSize.y);
+    fmt::format_to(std::back_inserter(out),
+                   "  \"config\": {{\"warmup\": {}, \"frames\": {}, \"headless\": {}, "
+                   "\"renderThread\": {}}},\n",
+                   config_.WarmupFrames, sampler_.GetCount(), config_.Headless,
+                   config_.RenderThread);
+    sampler_.AppendJson(out);
+    fmt::format_to(std::back_inserter(out),
+                   "  \"lastFrame\": {{\"drawCalls\": {}, \"shadowDrawCalls\": {}, "
+                   "\"triangles\": {}, \"programBinds\": {}, \"uniformUploads\": {}}}\n}}\n",
+                   total.DrawCalls, render.Counters.Pass(se::GpuPass::Shadow).DrawCalls,
+                   total.Triangles, total.ProgramBinds, total.UniformUploads);
+
+    std::fputs(out.c_str(), stdout);
+    std::fflush(stdout);
+}
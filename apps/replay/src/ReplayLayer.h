@@ -0,0 +1,48 @@
+#pragma once
+
+#include <engine/FrameStats.h>
+#include <engine/Layer.h>
+#include <engine/renderer/FrameCapture.h>
+#include <engine/renderer/Material.h>
+#include <engine/renderer/VertexArray.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ReplayConfig {
+    std::string CapturePath;
+    uint32_t WarmupFrames = 30;
+    // Measured frames before the report; 0 replays until the window is closed
+    uint32_t Frames = 300;
+    bool Headless = false;
+    bool RenderThread = false;
+};
+
+// Recreates the meshes, shaders and materials of a FrameCapture file, then hands the
+// captured submissions to SceneRenderer every frame exactly as the original scene did.
+// After WarmupFrames + Frames frames it prints CPU/GPU frame time percentiles and the
+// render counters as one JSON object and stops the application.
+class ReplayLayer : public se::Layer {
+  public:
+    ReplayLayer(const ReplayConfig& config, se::CapturedFrame frame);
+
+    void OnAttach() override;
+    void OnDetach() override;
+    void OnUpdate(float ts) override;
+    void OnRender() override;
+
+  private:
+    bool CreateResources();
+    void WriteReport() const;
+
+  private:
+    ReplayConfig config_;
+    se::CapturedFrame frame_;
+    std::vector<std::shared_ptr<se::VertexArray>> meshes_;
+    std::vector<std::shared_ptr<se::Material>> materials_;
+    bool ready_ = false;
+
+    se::FrameSampler sampler_;
+    bool done_ = false;
+};
@@ -0,0 +1,75 @@
+#include "ReplayLayer.h"
+#include <cstdlib>
+#include <cstring>
+#include <engine/Application.h>
+#include <engine/Log.h>
+#include <utility>
+
+int main(int argc, char** argv) {
+    ReplayConfig config;
+
+    // replay FILE [options]: re-render a frame captured with --capture-frame / F10
+    // --warmup N / --frames N: frames skipped, then frames measured (default 30 / 300);
+    //     --frames 0 replays until the window is closed
+    // --headless: offscreen run for CI
+    // --render-thread: submit from the dedicated render thread
+    // --trace FILE: write a Chrome trace of the profiler scopes on exit
+    // --metrics FILE|unix:SOCKET: stream per-frame metrics as JSON lines
+    // --verbose: keep the engine's info logging
+    bool verbose = false;
+    std::string tracePath;
+    std::string metricsOutput;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            config.WarmupFrames = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            config.Frames = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            config.Headless = true;
+        } else if (strcmp(argv[i], "--render-thread") == 0) {
+            config.RenderThread = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            metricsOutput = argv[++i];
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (argv[i][0] != '-') {
+            config.CapturePath = argv[i];
+        }
+    }
+
+    se::LogInit(false);
+    // The report goes to stdout; keep it readable
+    if (!verbose)
+        se::Logger()->set_level(spdlog::level::warn);
+
+    if (config.CapturePath.empty()) {
+        SE_LOG_ERROR("Usage: replay FILE [--frames N] [--warmup N] [--headless] "
+                     "[--render-thread] [--trace FILE] [--metrics FILE] [--verbose]");
+        return 1;
+    }
+
+    // Loaded before the window exists so it can match the captured viewport
+    std::optional<se::CapturedFrame> frame = se::FrameCapture::Load(config.CapturePath);
+    if (!frame)
+        return 1;
+
+    se::ApplicationSpec appSpec;
+    appSpec.Name = "Simple Engine Replay";
+    if (frame->ViewportSize.x > 0 && frame->ViewportSize.y > 0) {
+        appSpec.WindowWidth = static_cast<uint32_t>(frame->ViewportSize.x);
+        appSpec.WindowHeight = static_cast<uint32_t>(frame->ViewportSize.y);
+    }
+    // Measure the renderer, not the display: no VSync, no frame cap, no hitch dumps
+    appSpec.VSync = false;
+    appSpec.FlightRecorder = false;
+    appSpec.Headless = config.Headless;
+    appSpec.RenderThread = config.RenderThread;
+    appSpec.ProfileTracePath = tracePath;
+    appSpec.MetricsOutput = metricsOutput;
+
+    se::Application application(appSpec);
+    application.PushLayer<ReplayLayer>(config, std::move(*frame));
+    application.Run();
+}
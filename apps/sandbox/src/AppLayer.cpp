@@ -3,7 +3,10 @@
 #include <engine/Application.h>
 #include <engine/Input.h>
 #include <engine/Log.h>
+#include <engine/Profiler.h>
 #include <engine/ecs/Components.h>
+#include <engine/renderer/GpuProfiler.h>
+#include <engine/renderer/SceneRenderer.h>
 #include <gtc/type_ptr.hpp>
 #include <imgui.h>
 
@@ -18,6 +21,10 @@ void AppLayer::OnAttach() {
     // Material load
     LoadMaterial();
 
+    // Generate the meshes the scene uses in parallel, then upload them in one go
+    se::MeshManager::PreloadPrimitives({se::PrimitiveMeshType::Cube,
+                                        se::PrimitiveMeshType::Sphere});
+
     // Create scene
     scene_ = std::make_unique<se::Scene>("Main Scene");
 
@@ -40,6 +47,16 @@ void AppLayer::OnAttach() {
 
     InputHandler::setCursorModeFromString(window, "normal");
 
+    toggleCameraAction_ =
+        se::Input::RegisterAction("ToggleCamera", {se::InputBinding::Key(GLFW_KEY_TAB)});
+    spawnCubesAction_ =
+        se::Input::RegisterAction("SpawnCubes", {se::InputBinding::Key(GLFW_KEY_N),
+                                                 se::InputBinding::Key(GLFW_KEY_KP_ADD)});
+    captureTraceAction_ =
+        se::Input::RegisterAction("CaptureTrace", {se::InputBinding::Key(GLFW_KEY_F9)});
+    captureFrameAction_ =
+        se::Input::RegisterAction("CaptureFrame", {se::InputBinding::Key(GLFW_KEY_F10)});
+
     se::RenderCommand::SetClearColor({0.3f, 0.3f, 0.3f, 1.0f});
 }
 
@@ -48,6 +65,8 @@ void AppLayer::LoadMaterial() {
     fs::path fragment_shader_location = assets_folder.value() / "shaders" / "basic.frag";
     fs::path vertex_shader_location = assets_folder.value() / "shaders" / "basic.vert";
 
+    se::MaterialManager::PreloadShaders(
+        {{"DefaultShader", vertex_shader_location, fragment_shader_location}});
     std::shared_ptr<se::Shader> shader = se::MaterialManager::GetShader(
         "DefaultShader", vertex_shader_location, fragment_shader_location);
 
@@ -60,15 +79,19 @@ void AppLayer::OnDetach() {
     scene_.reset();
 }
 
-void AppLayer::OnEvent(se::Event& event) {
-    // Handle events if needed
+void AppLayer::OnEvents(se::EventQueue& events) {
+    // Mouse look and zoom; whatever ImGui captured is already marked handled
+    events.ForEach([this](se::Event& event) { inputHandler_.processEvent(event); });
 }
 
-void AppLayer::OnUpdate(float ts) {
-    animationTime_ += ts;
+void AppLayer::OnFixedUpdate(float ts) {
+    // Snapshot transforms for interpolation and run fixed-rate scene systems
+    scene_->OnFixedUpdate(ts);
 
-    // Update scene systems
-    scene_->OnUpdate(ts);
+    if (!animate_)
+        return;
+
+    animationTime_ += ts;
 
     // Update entity transforms
     auto view = scene_->GetAllEntitiesWith<se::TransformComponent, se::NameComponent>();
@@ -94,9 +117,18 @@ void AppLayer::OnUpdate(float ts) {
                                1.0f);
         }
     }
+}
+
+void AppLayer::OnUpdate(float ts) {
+    // Update scene systems
+    scene_->OnUpdate(ts);
 
     // Handle input
     HandleInput(ts);
+
+    // In on-demand mode, keep frames coming while something is moving
+    if (animate_)
+        se::Application::Get().RequestRedraw();
 }
 
 void AppLayer::OnRender() {
@@ -106,7 +138,7 @@ void AppLayer::OnRender() {
     float aspectRatio = windowSize.x / windowSize.y;
 
     // Scene automatically renders all entities with MeshRenderComponent!
-    scene_->OnRender(camera_, aspectRatio);
+    scene_->OnRender(camera_, aspectRatio, se::Application::Get().GetInterpolationAlpha());
 }
 
 void AppLayer::OnImGuiRender() {
@@ -182,12 +214,52 @@ void AppLayer::OnImGuiRender() {
     if (ImGui::CollapsingHeader("Render Stats")) {
         ImGui::Text("Draw Calls: %u", stats.DrawCalls);
         ImGui::Text("Triangles: %u", stats.TriangleCount);
+        se::PassCounters total = stats.Counters.Total();
+        ImGui::Text("State: %u programs | %u textures | %u uniforms", total.ProgramBinds,
+                    total.TextureBinds, total.UniformUploads);
+        ImGui::Text("Objects: %u submitted | %u culled", stats.Counters.ObjectsSubmitted,
+                    stats.Counters.ObjectsCulled);
+        ImGui::Text("Input -> Submit: %.2f ms", stats.InputToSubmitMs);
+        ImGui::Text("Fence Wait: %.2f ms", stats.FenceWaitMs);
+
+        se::FrameArenaStats arena = se::Application::Get().GetFrameArena().GetStats();
+        ImGui::Text("Frame Arena: %zu / %zu KiB (peak %zu KiB)", arena.UsedBytes / 1024,
+                    arena.CapacityBytes / 1024, arena.PeakBytes / 1024);
+        if (arena.OverflowBytes > 0)
+            ImGui::Text("Frame Arena overflow: %zu KiB", arena.OverflowBytes / 1024);
+
+        ImGui::Separator();
+        for (size_t i = 0; i < se::kGpuPassCount; ++i) {
+            const se::GpuPassStats& pass = stats.GpuPasses[i];
+            ImGui::Text("GPU %s: %.3f ms", se::GpuProfiler::GetPassName(se::GpuPass(i)),
+                        pass.Milliseconds);
+            if (se::GpuProfiler::IsPipelineStatisticsEnabled()) {
+                ImGui::Text("  verts %llu | prims %llu | frags %llu",
+                            (unsigned long long)pass.VerticesSubmitted,
+                            (unsigned long long)pass.PrimitivesSubmitted,
+                            (unsigned long long)pass.FragmentInvocations);
+            }
+        }
+        if (se::GpuProfiler::IsPipelineStatisticsSupported()) {
+            bool pipelineStats = se::GpuProfiler::IsPipelineStatisticsEnabled();
+            if (ImGui::Checkbox("Pipeline Statistics", &pipelineStats))
+                se::GpuProfiler::SetPipelineStatistics(pipelineStats);
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Main Thread Queue")) {
+        const auto& queueStats = se::Application::Get().GetMainThreadQueue().GetStats();
+        ImGui::Text("Backlog: %u task(s)", queueStats.Backlog);
+        ImGui::Text("Steps: %u | Completed: %u", queueStats.StepsRun, queueStats.TasksCompleted);
+        ImGui::Text("Time: %.2f / %.2f ms", queueStats.TimeMs, queueStats.BudgetMs);
     }
 
     ImGui::Separator();
 
     // Quick actions
     if (ImGui::CollapsingHeader("Quick Actions")) {
+        ImGui::Checkbox("Animate", &animate_);
+
         if (ImGui::Button("Add Cube")) {
             static int cubeCount = 0;
             float x = (rand() % 10 - 5) * 0.5f;
@@ -197,6 +269,12 @@ void AppLayer::OnImGuiRender() {
 
         ImGui::SameLine();
 
+        if (ImGui::Button("Spawn 500 Cubes")) {
+            SpawnCubesOverTime(500);
+        }
+
+        ImGui::SameLine();
+
         if (ImGui::Button("Add Sphere")) {
             static int sphereCount = 0;
             float x = (rand() % 10 - 5) * 0.5f;
@@ -212,6 +290,22 @@ void AppLayer::OnImGuiRender() {
             scene_->Clear();
             SE_LOG_INFO("Scene cleared");
         }
+
+        if (ImGui::Button("Capture Trace (F9)")) {
+            se::Profiler::WriteChromeTrace("logs/trace.json");
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Capture Frame (F10)")) {
+            se::SceneRenderer::CaptureNextScene("logs/frame.sefc");
+        }
+        if (se::FlightRecorder* recorder = se::Application::Get().GetFlightRecorder()) {
+            ImGui::SameLine();
+            if (ImGui::Button("Dump Flight Recorder")) {
+                recorder->Dump("manual");
+            }
+            ImGui::Text("Hitches: %u (median busy %.2f ms)", recorder->GetHitchCount(),
+                        recorder->GetMedianBusyMs());
+        }
     }
 
     ImGui::End();
@@ -222,17 +316,50 @@ void AppLayer::HandleInput(float deltaTime) {
     GLFWwindow* window = app.GetWindow().GetNativeWindow();
 
     if (window) {
+        glm::vec3 previousPosition = camera_.GetPosition();
         inputHandler_.processKeyboard(window, deltaTime);
+        if (camera_.GetPosition() != previousPosition)
+            app.RequestRedraw();
     }
 
-    if (se::Input::IsKeyPressed(GLFW_KEY_TAB)) {
+    if (se::Input::IsActionPressed(toggleCameraAction_)) {
         camera_active_ = !camera_active_;
         camera_.SetActive(camera_active_);
     }
+
+    // Keyboard twin of the "Spawn 500 Cubes" button, so spawning ends up in input recordings
+    if (se::Input::IsActionPressed(spawnCubesAction_))
+        SpawnCubesOverTime(500);
+
+    // Open the file in ui.perfetto.dev or chrome://tracing
+    if (se::Input::IsActionPressed(captureTraceAction_))
+        se::Profiler::WriteChromeTrace("logs/trace.json");
+
+    // Re-render the captured scene with the replay app
+    if (se::Input::IsActionPressed(captureFrameAction_))
+        se::SceneRenderer::CaptureNextScene("logs/frame.sefc");
 }
 
 // ==================== Entity Creation Helpers ====================
 
+void AppLayer::SpawnCubesOverTime(int count) {
+    // A few cubes per step; the queue spreads the steps over as many frames as it takes
+    static int spawnedTotal = 0;
+    auto remaining = std::make_shared<int>(count);
+
+    se::Application::Get().GetMainThreadQueue().Enqueue(
+        [this, remaining]() {
+            for (int i = 0; i < 10 && *remaining > 0; ++i, --*remaining) {
+                float x = (rand() % 40 - 20) * 0.5f;
+                float z = (rand() % 40 - 20) * 0.5f;
+                CreateCubeEntity("Spawned_" + std::to_string(spawnedTotal++), {x, 0.0f, z},
+                                 glm::vec3(0.3f));
+            }
+            return *remaining > 0 ? se::TaskStatus::Continue : se::TaskStatus::Done;
+        },
+        se::TaskPriority::Low);
+}
+
 void AppLayer::CreateCubeEntity(const std::string& name, const glm::vec3& position,
                                 const glm::vec3& scale) {
     SE_LOG_INFO("Creating cube entity: {}", name);
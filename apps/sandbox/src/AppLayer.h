@@ -1,6 +1,7 @@
 #pragma once
 
 #include <engine/Camera.h>
+#include <engine/Input.h>
 #include <engine/InputHandler.h>
 #include <engine/Layer.h>
 #include <engine/ecs/Scene.h>
@@ -20,7 +21,9 @@ class AppLayer : public se::Layer {
 
     void OnDetach() override;
 
-    void OnEvent(se::Event& event) override;
+    void OnEvents(se::EventQueue& events) override;
+
+    void OnFixedUpdate(float ts) override;
 
     void OnUpdate(float ts) override;
 
@@ -43,6 +46,9 @@ class AppLayer : public se::Layer {
 
     void CreateCapsuleEntity(const std::string& name, const glm::vec3& position);
 
+    // Spawn cubes through the main-thread queue instead of all in one frame
+    void SpawnCubesOverTime(int count);
+
   private:
     // Scene
     std::unique_ptr<se::Scene> scene_;
@@ -56,8 +62,14 @@ class AppLayer : public se::Layer {
 
     // Animation time
     float animationTime_ = 0.0f;
+    bool animate_ = true;
 
     float yaw_ = 0.0f;
 
     bool camera_active_ = true;
+
+    se::InputAction toggleCameraAction_ = se::kInvalidInputAction;
+    se::InputAction spawnCubesAction_ = se::kInvalidInputAction;
+    se::InputAction captureTraceAction_ = se::kInvalidInputAction;
+    se::InputAction captureFrameAction_ = se::kInvalidInputAction;
 };
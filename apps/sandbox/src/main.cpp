@@ -1,15 +1,55 @@
 #include "AppLayer.h"
+#include <cstring>
 #include <engine/Application.h>
 #include <engine/Log.h>
 
 using namespace std;
 
-int main() {
+int main(int argc, char** argv) {
     se::ApplicationSpec appSpec;
     appSpec.Name = "Simple engine";
     appSpec.WindowWidth = 1920;
     appSpec.WindowHeight = 1080;
 
+    // --headless [--frames N]: offscreen run for CI / soak tests
+    // --fps N: turn VSync off and cap the frame rate instead
+    // --on-demand: only render on input/changes (editor-style idle)
+    // --render-thread: record frames and submit them from a dedicated render thread
+    // --record-input FILE / --replay-input FILE: capture or replay per-frame input
+    // --trace FILE: write a Chrome trace of the profiler scopes on exit
+    // --perf-counters: sample CPU performance counters per frame (Linux)
+    // --metrics FILE|unix:SOCKET [--metrics-csv]: stream per-frame metrics as JSON lines / CSV
+    // --capture-frame N FILE: write frame N's scene to FILE for apps/replay
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            appSpec.Headless = true;
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            appSpec.HeadlessFrameCount = static_cast<uint32_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            appSpec.VSync = false;
+            appSpec.TargetFrameRate = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--on-demand") == 0) {
+            appSpec.Mode = se::RenderMode::OnDemand;
+        } else if (strcmp(argv[i], "--render-thread") == 0) {
+            appSpec.RenderThread = true;
+        } else if (strcmp(argv[i], "--record-input") == 0 && i + 1 < argc) {
+            appSpec.InputRecordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc) {
+            appSpec.InputReplayPath = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            appSpec.ProfileTracePath = argv[++i];
+        } else if (strcmp(argv[i], "--perf-counters") == 0) {
+            appSpec.HardwareCounters = true;
+        } else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) {
+            appSpec.MetricsOutput = argv[++i];
+        } else if (strcmp(argv[i], "--metrics-csv") == 0) {
+            appSpec.MetricsOutputFormat = se::MetricsFormat::Csv;
+        } else if (strcmp(argv[i], "--capture-frame") == 0 && i + 2 < argc) {
+            appSpec.CaptureFrame = static_cast<uint32_t>(atoi(argv[++i]));
+            appSpec.CaptureFramePath = argv[++i];
+        }
+    }
+
     se::LogInit(true);
 
     se::Application application(appSpec);
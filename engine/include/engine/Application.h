@@ -1,9 +1,23 @@
 #pragma once
 
+#include "engine/FlightRecorder.h"
+#include "engine/FrameLimiter.h"
+#include "engine/FrameStats.h"
 #include "engine/ImGuiLayer.h"
+#include "engine/InputRecorder.h"
 #include "engine/Layer.h"
+#include "engine/MainThreadQueue.h"
+#include "engine/MetricsExporter.h"
 #include "engine/Renderer.h"
+#include "engine/StartupTimer.h"
 #include "engine/Window.h"
+#include "engine/jobs/JobSystem.h"
+#include "engine/memory/FrameArena.h"
+#include "engine/renderer/RenderCommandBuffer.h"
+#include "engine/renderer/RenderThread.h"
+#include "engine/renderer/renderer_v2.h"
+#include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -17,10 +31,19 @@ class Application {
     int Run();
     void Stop();
 
-    template <typename T>
-    void PushLayer() {
+    // OnDemand mode: render the next `frames` frames. Layers call this when their state
+    // changed, or every frame while an animation is running. Safe from any thread.
+    void RequestRedraw(uint32_t frames = 1);
+
+    RenderMode GetRenderMode() const {
+        return renderMode_;
+    }
+
+    template <typename T, typename... Args>
+    void PushLayer(Args&&... args) {
         static_assert(std::is_base_of<Layer, T>::value, "T must inherit from Layer");
-        auto layer = std::make_unique<T>();
+        auto layer = std::make_unique<T>(std::forward<Args>(args)...);
+        StartupTimer::Scope timing(startupTimer_, "Attach " + layer->GetName());
         layer->OnAttach();
         layer_stack_.push_back(std::move(layer));
     }
@@ -33,18 +56,108 @@ class Application {
     Renderer& GetRenderer() {
         return *renderer_;
     }
+    JobSystem& GetJobSystem() {
+        return *jobSystem_;
+    }
+    FrameArena& GetFrameArena() {
+        return *frameArena_;
+    }
+
+    // Offscreen render target used in headless mode (Handle is 0 otherwise)
+    const ::Renderer::Framebuffer& GetOffscreenFramebuffer() const {
+        return offscreenTarget_;
+    }
 
     static Application& Get();
 
     float GetTime();
 
+    MainThreadQueue& GetMainThreadQueue() {
+        return mainThreadQueue_;
+    }
+
+    FrameLimiter& GetFrameLimiter() {
+        return frameLimiter_;
+    }
+
+    InputRecorder& GetInputRecorder() {
+        return inputRecorder_;
+    }
+
+    // Timings and counters of the last completed frame (read from OnUpdate, it is the
+    // previous frame)
+    const FrameRecord& GetLastFrameRecord() const {
+        return lastFrameRecord_;
+    }
+
+    // Null when disabled in the ApplicationSpec
+    FlightRecorder* GetFlightRecorder() {
+        return flightRecorder_.get();
+    }
+
+    float GetFixedTimestep() const {
+        return fixedTimestep_;
+    }
+
+    // How far the current frame is between the last two fixed steps, in [0, 1).
+    // Renderers blend the previous and current simulation state with it.
+    float GetInterpolationAlpha() const {
+        return interpolationAlpha_;
+    }
+
+  private:
+    void CreateOffscreenTarget();
+    // Hand the window's pending events to ImGui and the layers (top first), then clear them
+    void DispatchEvents();
+    // Hand the recorded frame to the render thread after a short main-thread sync point
+    void SubmitRecordedFrame();
+
   private:
+    StartupTimer startupTimer_;
+
+    // Created first, destroyed last: layers, scenes and resource managers may use it
+    std::unique_ptr<JobSystem> jobSystem_;
+    // Before the renderer, whose transient containers draw from it
+    std::unique_ptr<FrameArena> frameArena_;
     std::unique_ptr<Window> window_;
     std::unique_ptr<Renderer> renderer_;
     std::shared_ptr<ImGuiLayer> imguiLayer_;
 
     std::vector<std::unique_ptr<Layer>> layer_stack_;
-    bool running_ = false;
+    std::atomic<bool> running_{false};
+
+    FrameLimiter frameLimiter_;
+    MainThreadQueue mainThreadQueue_;
+    InputRecorder inputRecorder_;
+    std::string profileTracePath_;
+    // Filled while a frame runs; complete once the frame has ended
+    FrameRecord frameRecord_;
+    FrameRecord lastFrameRecord_;
+    std::unique_ptr<FlightRecorder> flightRecorder_;
+    // Null unless ApplicationSpec::MetricsOutput is set
+    std::unique_ptr<MetricsExporter> metricsExporter_;
+    std::string captureFramePath_;
+    uint32_t captureFrame_ = 0;
+
+    // Threaded rendering: frames are recorded into alternating buffers while the render
+    // thread executes the previous one
+    std::unique_ptr<RenderThread> renderThread_;
+    std::array<RenderCommandBuffer, 2> commandBuffers_;
+    uint32_t recordIndex_ = 0;
+
+    float fixedTimestep_ = 0.0f;
+    uint32_t maxFixedStepsPerFrame_ = 5;
+    float fixedAccumulator_ = 0.0f;
+    float interpolationAlpha_ = 1.0f;
+
+    bool justInTimeInput_ = false;
+
+    RenderMode renderMode_ = RenderMode::Continuous;
+    float idleWaitTimeout_ = 0.5f;
+    std::atomic<uint32_t> pendingRedraws_{0};
+
+    ::Renderer::Framebuffer offscreenTarget_;
+    uint32_t headlessFrameCount_ = 0;
 
     static Application* s_Instance;
 };
@@ -1,7 +1,103 @@
 #pragma once
 
+#include <cstdint>
+
 namespace se {
 
-class Event {};
+enum class EventType : uint8_t {
+    None = 0,
+    WindowResize, // Framebuffer size in pixels
+    WindowClose,
+    KeyPressed,
+    KeyReleased,
+    MouseButtonPressed,
+    MouseButtonReleased,
+    MouseMoved,
+    MouseScrolled,
+};
+
+// Small POD so events can live in a preallocated ring buffer (see EventQueue). Only the
+// payload matching Type is valid.
+struct Event {
+    struct ResizePayload {
+        uint32_t Width;
+        uint32_t Height;
+    };
+    struct KeyPayload {
+        int Code; // GLFW key
+        int Mods;
+        bool Repeat;
+    };
+    struct MouseButtonPayload {
+        int Button;
+        int Mods;
+    };
+    struct MousePayload {
+        float X; // MouseMoved: cursor position, MouseScrolled: offset
+        float Y;
+    };
+
+    EventType Type = EventType::None;
+    // Set by a layer to stop the event from reaching the layers below it
+    bool Handled = false;
+
+    union {
+        ResizePayload Resize;
+        KeyPayload Key;
+        MouseButtonPayload MouseButton;
+        MousePayload Mouse;
+    };
+
+    Event() : Resize{0, 0} {}
+
+    bool IsKeyboard() const {
+        return Type == EventType::KeyPressed || Type == EventType::KeyReleased;
+    }
+
+    bool IsMouse() const {
+        return Type >= EventType::MouseButtonPressed && Type <= EventType::MouseScrolled;
+    }
+
+    static Event WindowResized(uint32_t width, uint32_t height) {
+        Event event;
+        event.Type = EventType::WindowResize;
+        event.Resize = {width, height};
+        return event;
+    }
+
+    static Event WindowClosed() {
+        Event event;
+        event.Type = EventType::WindowClose;
+        return event;
+    }
+
+    static Event KeyChanged(int key, bool pressed, int mods = 0, bool repeat = false) {
+        Event event;
+        event.Type = pressed ? EventType::KeyPressed : EventType::KeyReleased;
+        event.Key = {key, mods, repeat};
+        return event;
+    }
+
+    static Event MouseButtonChanged(int button, bool pressed, int mods = 0) {
+        Event event;
+        event.Type = pressed ? EventType::MouseButtonPressed : EventType::MouseButtonReleased;
+        event.MouseButton = {button, mods};
+        return event;
+    }
+
+    static Event MouseMoved(float x, float y) {
+        Event event;
+        event.Type = EventType::MouseMoved;
+        event.Mouse = {x, y};
+        return event;
+    }
+
+    static Event MouseScrolled(float xOffset, float yOffset) {
+        Event event;
+        event.Type = EventType::MouseScrolled;
+        event.Mouse = {xOffset, yOffset};
+        return event;
+    }
+};
 
 } // namespace se
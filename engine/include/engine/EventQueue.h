@@ -0,0 +1,73 @@
+#pragma once
+
+#include "engine/Event.h"
+#include <array>
+#include <cstdint>
+
+namespace se {
+
+// Fixed-capacity ring buffer of events. GLFW callbacks push into it as events arrive and
+// Application dispatches the whole batch once per frame, so no event allocates.
+//
+// Bursts are coalesced on push: consecutive mouse moves keep only the latest position,
+// consecutive scrolls are summed, and a frame never carries more than one resize.
+class EventQueue {
+  public:
+    static constexpr uint32_t kCapacity = 512;
+
+    // Main thread only (GLFW delivers callbacks there). Drops the event when full.
+    void Push(const Event& event);
+
+    // Visit pending events in arrival order, skipping the ones already handled
+    template <typename Fn>
+    void ForEach(Fn&& fn) {
+        for (uint32_t i = 0; i < count_; ++i) {
+            Event& event = events_[(head_ + i) % kCapacity];
+            if (!event.Handled)
+                fn(event);
+        }
+    }
+
+    // Visit every pending event, handled or not
+    template <typename Fn>
+    void ForEachRaw(Fn&& fn) const {
+        for (uint32_t i = 0; i < count_; ++i)
+            fn(events_[(head_ + i) % kCapacity]);
+    }
+
+    // Drop mouse and keyboard events (input replay substitutes its own)
+    void DiscardInput();
+
+    // Consume the batch; the slots are reused by the next pushes
+    void Clear();
+
+    uint32_t GetCount() const {
+        return count_;
+    }
+
+    bool IsEmpty() const {
+        return count_ == 0;
+    }
+
+    // Events dropped because the buffer was full, since the last Clear()
+    uint32_t GetDroppedCount() const {
+        return dropped_;
+    }
+
+  private:
+    Event& Back() {
+        return events_[(head_ + count_ - 1) % kCapacity];
+    }
+
+  private:
+    std::array<Event, kCapacity> events_;
+    uint32_t head_ = 0;
+    uint32_t count_ = 0;
+    uint32_t dropped_ = 0;
+
+    // Slot (offset from head_) of the pending resize, if any
+    static constexpr uint32_t kNoResize = ~0u;
+    uint32_t resizeSlot_ = kNoResize;
+};
+
+} // namespace se
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "engine/FrameStats.h"
+#include "engine/jobs/JobSystem.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace se {
+
+struct FlightRecorderSpec {
+    // Frames kept in memory (and written per dump)
+    uint32_t FrameCount = 300;
+    // A frame is a hitch when its busy time exceeds HitchFactor times the rolling median
+    // and HitchMinMs
+    float HitchFactor = 3.0f;
+    float HitchMinMs = 50.0f;
+    std::string OutputDirectory = "logs/hitches";
+    // Dumps per session; later hitches are only counted
+    uint32_t MaxDumps = 16;
+};
+
+// Always-on ring of the last frames' FrameRecords. When a frame's busy time (FrameMs minus
+// the frame limiter wait) spikes past the threshold, the buffered frames, the profiler
+// scopes in that window (SE_PROFILE builds) and the recent log lines are written as one
+// Chrome trace JSON file (ui.perfetto.dev, chrome://tracing) for a post-mortem.
+//
+// Detection costs a record copy and a median of FrameCount floats per frame. The data is
+// captured on the main thread; formatting and writing run as a job.
+class FlightRecorder {
+  public:
+    // Frames needed before hitches are detected, so startup isn't reported
+    static constexpr uint32_t kWarmupFrames = 30;
+
+    FlightRecorder(const FlightRecorderSpec& spec, JobSystem* jobSystem);
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Called by Application when a frame has ended
+    void AddFrame(const FrameRecord& record);
+
+    // Dump the buffer now, regardless of hitches
+    void Dump(const char* reason);
+
+    float GetMedianBusyMs() const {
+        return medianBusyMs_;
+    }
+    uint32_t GetHitchCount() const {
+        return hitchCount_;
+    }
+    const std::string& GetLastDumpPath() const {
+        return lastDumpPath_;
+    }
+
+  private:
+    static float BusyMs(const FrameRecord& record);
+
+    const FrameRecord& GetFrame(uint32_t age) const;
+    void UpdateMedian();
+
+  private:
+    FlightRecorderSpec spec_;
+    JobSystem* jobSystem_;
+    JobCounter pendingDumps_;
+
+    std::vector<FrameRecord> frames_;
+    uint32_t head_ = 0; // Next slot to write
+    uint32_t count_ = 0;
+
+    std::vector<float> medianScratch_;
+    float medianBusyMs_ = 0.0f;
+
+    uint32_t hitchCount_ = 0;
+    uint32_t dumpCount_ = 0;
+    std::string lastDumpPath_;
+};
+
+} // namespace se
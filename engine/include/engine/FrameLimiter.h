@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+
+namespace se {
+
+// Caps the frame rate when VSync is off. Waits with a hybrid sleep-then-spin: the OS sleep
+// covers most of the interval and the last stretch (sized from measured sleep overshoot)
+// is spun on steady_clock, which keeps frame times tight without pinning a core.
+class FrameLimiter {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // 0 (or negative) disables the limiter
+    void SetTargetFrameRate(float framesPerSecond);
+
+    // With pacing, deadlines are laid on a fixed grid (previous deadline + frame time) so
+    // present times stay evenly spaced; without it each frame waits a full frame time
+    // from the end of the previous wait.
+    void SetPacing(bool enabled) {
+        pacing_ = enabled;
+    }
+
+    bool IsEnabled() const {
+        return targetFrameTime_.count() > 0;
+    }
+
+    Clock::duration GetTargetFrameTime() const {
+        return targetFrameTime_;
+    }
+
+    // Block until the next frame deadline. Call once per frame, right after present.
+    void Wait();
+
+  private:
+    void SleepUntil(Clock::time_point deadline);
+
+  private:
+    Clock::duration targetFrameTime_{0};
+    Clock::time_point nextDeadline_{};
+    bool pacing_ = true;
+
+    // How late the OS sleep tends to wake up (moving average), and the spin window
+    // derived from it
+    Clock::duration sleepOvershoot_ = std::chrono::microseconds(500);
+    Clock::duration spinWindow_ = std::chrono::milliseconds(1);
+};
+
+} // namespace se
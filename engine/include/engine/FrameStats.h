@@ -0,0 +1,147 @@
+#pragma once
+
+#include "engine/HardwareCounters.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
+#include "engine/renderer/SceneRenderer.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace se {
+
+// Main-thread phases of Application::Run, in frame order
+enum class FramePhase : uint8_t {
+    Input,
+    FixedUpdate,
+    Update,
+    Render,
+    MainThreadQueue,
+    ImGui,
+    Submit, // SwapBuffers, or the hand-off to the render thread
+    Wait,   // Frame limiter and event polling
+    Count
+};
+
+constexpr size_t kFramePhaseCount = static_cast<size_t>(FramePhase::Count);
+
+inline const char* GetFramePhaseName(FramePhase phase) {
+    constexpr const char* kNames[kFramePhaseCount] = {
+        "Input", "Fixed Update", "Update", "Render", "Main Thread Queue", "ImGui", "Submit",
+        "Wait"};
+    return phase < FramePhase::Count ? kNames[static_cast<size_t>(phase)] : "Unknown";
+}
+
+struct LayerTiming {
+    const char* Name = nullptr; // Layer::GetProfileName()
+    float UpdateMs = 0.0f;      // OnFixedUpdate + OnUpdate
+    float RenderMs = 0.0f;
+    float ImGuiMs = 0.0f;
+};
+
+// Where one frame's time went. Filled by Application every frame, whether or not the
+// SE_PROFILE_* scopes are compiled in.
+struct FrameRecord {
+    static constexpr uint32_t kMaxLayers = 8;
+
+    uint64_t Index = 0;
+    uint64_t StartNs = 0; // Profiler::Now() at the top of the frame
+    uint64_t EndNs = 0;
+    float FrameMs = 0.0f;
+    std::array<float, kFramePhaseCount> PhaseMs{};
+    std::array<LayerTiming, kMaxLayers> Layers{};
+    uint32_t LayerCount = 0;
+    // Counters, CPU pass times and (a few frames old) GPU pass times
+    RenderStats Render;
+    // Zeros unless built with SE_TRACK_ALLOCATIONS
+    AllocationFrameStats Allocations;
+    // Zeros unless HardwareCounters are enabled
+    HardwareFrameStats Hardware;
+
+    float& Phase(FramePhase phase) {
+        return PhaseMs[static_cast<size_t>(phase)];
+    }
+    float GetPhase(FramePhase phase) const {
+        return PhaseMs[static_cast<size_t>(phase)];
+    }
+
+    // Layers past kMaxLayers are folded into the last slot
+    LayerTiming& Layer(uint32_t index, const char* name) {
+        index = index < kMaxLayers ? index : kMaxLayers - 1;
+        LayerCount = LayerCount > index ? LayerCount : index + 1;
+        if (!Layers[index].Name)
+            Layers[index].Name = name;
+        return Layers[index];
+    }
+};
+
+// Adds the time until it goes out of scope to a FrameRecord field
+class FrameTimer {
+  public:
+    explicit FrameTimer(float& milliseconds)
+        : milliseconds_(milliseconds), start_(Profiler::Now()) {}
+    ~FrameTimer() {
+        milliseconds_ += static_cast<float>((Profiler::Now() - start_) / 1.0e6);
+    }
+
+    FrameTimer(const FrameTimer&) = delete;
+    FrameTimer& operator=(const FrameTimer&) = delete;
+
+  private:
+    float& milliseconds_;
+    uint64_t start_;
+};
+
+// Nearest-rank percentile (percentile in (0, 1]) of count values; reorders them
+float Percentile(float* values, size_t count, float percentile);
+
+struct SampleSummary {
+    float Min = 0.0f;
+    float Avg = 0.0f;
+    float P50 = 0.0f;
+    float P99 = 0.0f;
+    float Max = 0.0f;
+};
+
+SampleSummary Summarize(std::vector<float> samples);
+
+// Per-frame times of a measured run (bench, replay). Feed it
+// Application::GetLastFrameRecord() once per frame: records of the first warmupFrames
+// frames, and incomplete ones, are skipped.
+class FrameSampler {
+  public:
+    FrameSampler(uint64_t warmupFrames, uint32_t frames);
+
+    // False if the record was skipped or the run already has all its frames
+    bool Add(const FrameRecord& record);
+
+    bool IsDone() const {
+        return frameMs_.size() >= frames_;
+    }
+    size_t GetCount() const {
+        return frameMs_.size();
+    }
+    uint64_t GetFirstFrame() const {
+        return firstFrame_;
+    }
+    const FrameRecord& GetLastRecord() const {
+        return lastRecord_;
+    }
+
+    // One JSON member line (`  "name": {...},`) per series: cpuFrameMs, cpuBusyMs
+    // (frame time minus the limiter/poll wait), cpuRenderMs and gpuFrameMs
+    void AppendJson(std::string& out) const;
+
+  private:
+    uint64_t warmupFrames_;
+    uint32_t frames_;
+    std::vector<float> frameMs_;
+    std::vector<float> busyMs_;
+    std::vector<float> renderMs_;
+    std::vector<float> gpuMs_;
+    uint64_t firstFrame_ = 0;
+    FrameRecord lastRecord_;
+};
+
+} // namespace se
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace se {
+
+enum class HardwareCounter : uint8_t {
+    Cycles,
+    Instructions,
+    L1DMisses, // L1 data cache read misses
+    LLCMisses, // Last-level cache misses
+    BranchMisses,
+    PageFaults, // Software event; usually available where the PMU is not (VMs)
+    Count
+};
+
+constexpr size_t kHardwareCounterCount = static_cast<size_t>(HardwareCounter::Count);
+
+struct CounterValues {
+    std::array<uint64_t, kHardwareCounterCount> Values{};
+
+    uint64_t Get(HardwareCounter counter) const {
+        return Values[static_cast<size_t>(counter)];
+    }
+    // 0 when cycles aren't counted
+    float InstructionsPerCycle() const {
+        uint64_t cycles = Get(HardwareCounter::Cycles);
+        return cycles ? static_cast<float>(Get(HardwareCounter::Instructions)) / cycles : 0.0f;
+    }
+
+    CounterValues& operator+=(const CounterValues& other) {
+        for (size_t i = 0; i < kHardwareCounterCount; ++i)
+            Values[i] += other.Values[i];
+        return *this;
+    }
+    // Counters only grow; a smaller value (thread restarted) reads as 0
+    CounterValues operator-(const CounterValues& other) const {
+        CounterValues delta;
+        for (size_t i = 0; i < kHardwareCounterCount; ++i)
+            delta.Values[i] = Values[i] > other.Values[i] ? Values[i] - other.Values[i] : 0;
+        return delta;
+    }
+};
+
+struct CounterScopeStats {
+    const char* Name = nullptr;
+    uint32_t Calls = 0;
+    CounterValues Values;
+};
+
+struct HardwareFrameStats {
+    static constexpr uint32_t kMaxScopes = 16;
+
+    CounterValues MainThread;
+    CounterValues Workers; // Every job worker combined
+    std::array<CounterScopeStats, kMaxScopes> Scopes{};
+    uint32_t ScopeCount = 0;
+};
+
+// CPU performance counters from perf_event_open (Linux only). Off until Enable(), which
+// opens a counter group for the calling thread (the main thread); job workers open theirs
+// when they run their next job. EndFrame() turns the running counts into per-frame
+// deltas for the main thread, the workers, and every SE_COUNTERS_SCOPE.
+//
+// Counters the CPU or the kernel don't offer (most VMs have no PMU) stay zero; see
+// IsAvailable(). A scope costs two read() syscalls while enabled, so put them around
+// whole systems, not per-entity functions. The macro compiles to nothing without
+// SE_PROFILE.
+class HardwareCounters {
+  public:
+    // Identifies one SE_COUNTERS_SCOPE call site; registered on first use
+    class ScopeSlot {
+      public:
+        explicit ScopeSlot(const char* name);
+
+      private:
+        friend class HardwareCounters;
+        uint32_t index_;
+    };
+
+    class Scope {
+      public:
+        explicit Scope(const ScopeSlot& slot);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        uint32_t slot_;
+        bool active_ = false;
+        CounterValues start_;
+    };
+
+    // Returns false (and logs why) if no counter could be opened
+    static bool Enable();
+    static bool IsEnabled();
+    static bool IsAvailable(HardwareCounter counter);
+
+    // Open the calling thread's counters if enabled and not done yet. Cheap once attached.
+    static void AttachThread(bool worker);
+
+    // Running totals of the calling thread; false if it has no counters open
+    static bool ReadThread(CounterValues& values);
+
+    // Called by Application once per frame, on the main thread
+    static void EndFrame();
+    static const HardwareFrameStats& GetLastFrame();
+
+    static const char* GetCounterName(HardwareCounter counter);
+
+  private:
+    HardwareCounters() = delete;
+};
+
+} // namespace se
+
+#define SE_COUNTERS_CONCAT_IMPL(a, b) a##b
+#define SE_COUNTERS_CONCAT(a, b) SE_COUNTERS_CONCAT_IMPL(a, b)
+
+#ifdef SE_PROFILE
+#    define SE_COUNTERS_SCOPE(name)                                                              \
+        static const ::se::HardwareCounters::ScopeSlot SE_COUNTERS_CONCAT(seCounterSlot,         \
+                                                                          __LINE__)(name);       \
+        ::se::HardwareCounters::Scope SE_COUNTERS_CONCAT(seCounterScope, __LINE__)(              \
+            SE_COUNTERS_CONCAT(seCounterSlot, __LINE__))
+#else
+#    define SE_COUNTERS_SCOPE(name)
+#endif
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "engine/Input.h"
 #include "engine/Layer.h"
+#include "engine/PerformancePanel.h"
+#include <array>
+#include <imgui.h>
 
 struct GLFWwindow;
 
@@ -15,15 +19,46 @@ class ImGuiLayer : public Layer {
     void OnDetach() override;
     void OnUpdate(float ts) override;
     void OnRender() override;
-    void OnEvent(Event& event) override;
+    // Engine overlays, drawn after every layer's ImGui
+    void OnImGuiRender() override;
+    void OnEvents(EventQueue& events) override;
 
     void Begin(); // Start new ImGui frame
     void End();   // Render ImGui draw data
 
     void SetWindow(GLFWwindow* window);
 
+    // Record ImGui rendering for the render thread instead of drawing immediately. Must be
+    // set before OnAttach; disables multi-viewports (those need GL on the main thread).
+    void SetThreadedRendering(bool enabled) {
+        threaded_ = enabled;
+    }
+
+    PerformancePanel& GetPerformancePanel() {
+        return performancePanel_;
+    }
+
+  private:
+    // Copy of a frame's draw lists, so the render thread can draw it while the main thread
+    // already builds the next ImGui frame
+    struct DrawDataSnapshot {
+        ImDrawData Data;
+        ImVector<ImDrawList*> Lists;
+    };
+
+    void CaptureDrawData(DrawDataSnapshot& snapshot);
+    static void FreeSnapshot(DrawDataSnapshot& snapshot);
+    static void RenderSnapshot(void* snapshot);
+
   private:
     GLFWwindow* window_ = nullptr;
+    bool threaded_ = false;
+    // Double-buffered: one may still be drawing while the other is captured
+    std::array<DrawDataSnapshot, 2> snapshots_;
+    uint32_t snapshotIndex_ = 0;
+
+    PerformancePanel performancePanel_;
+    InputAction togglePerformanceAction_ = kInvalidInputAction;
 };
 
 } // namespace se
\ No newline at end of file
@@ -1,35 +1,119 @@
 #pragma once
 
+#include <bitset>
+#include <cstdint>
 #include <glm.hpp>
+#include <string>
+#include <vector>
 
 struct GLFWwindow;
 
 namespace se {
+
+class EventQueue;
+
+// One physical input an action listens to
+struct InputBinding {
+    enum class Device : uint8_t { Keyboard, Mouse };
+
+    Device Source = Device::Keyboard;
+    int Code = 0; // GLFW key or mouse button
+
+    static InputBinding Key(int keycode) {
+        return {Device::Keyboard, keycode};
+    }
+    static InputBinding MouseButton(int button) {
+        return {Device::Mouse, button};
+    }
+};
+
+using InputAction = uint32_t;
+constexpr InputAction kInvalidInputAction = ~0u;
+
+// Frame-coherent input. Window events update a live state; BeginFrame() copies it into the
+// snapshot every query reads, so all layers see the same input for the whole frame and a
+// query is a bit test (no driver calls).
+//
+//   Pressed  - went down this frame
+//   Down     - held this frame
+//   Released - went up this frame
 class Input {
   public:
+    static constexpr uint32_t kKeyCount = 352; // GLFW_KEY_LAST + 1, rounded up to a byte
+    static constexpr uint32_t kMouseButtonCount = 8;
+    static constexpr uint32_t kMaxActions = 64;
+
     static bool IsKeyPressed(int keycode);
 
     static bool IsKeyDown(int keycode);
 
-    bool IsKeyReleased(int keycode);
+    static bool IsKeyReleased(int keycode);
 
     static bool IsMouseButtonPressed(int button);
 
+    static bool IsMouseButtonDown(int button);
+
+    static bool IsMouseButtonReleased(int button);
+
     static glm::vec2 GetMousePosition();
 
     static float GetMouseX();
 
     static float GetMouseY();
 
+    // Scroll offset accumulated over the frame
+    static glm::vec2 GetMouseScroll();
+
+    // Action map: named actions bound to any number of keys/buttons. Registering an
+    // existing name replaces its bindings. Query with the returned id; name lookups are
+    // meant for setup code.
+    static InputAction RegisterAction(const std::string& name,
+                                      const std::vector<InputBinding>& bindings);
+    static InputAction GetAction(const std::string& name);
+    static void ClearActions();
+
+    static bool IsActionPressed(InputAction action);
+    static bool IsActionDown(InputAction action);
+    static bool IsActionReleased(InputAction action);
+
+    // Fold a batch of window events into the live state. Called by Application before
+    // the events are dispatched to layers (the batch may be consumed afterwards).
+    static void ApplyEvents(const EventQueue& events);
+
+    // Take the snapshot for the coming frame. Called by Application once per frame.
+    static void BeginFrame();
+
     // Internal: Used by Window to set the context
     static void SetWindow(GLFWwindow* window);
 
   private:
     Input() = delete;
 
+    struct State {
+        std::bitset<kKeyCount> Keys;
+        std::bitset<kMouseButtonCount> MouseButtons;
+        glm::vec2 Cursor{0.0f};
+        glm::vec2 Scroll{0.0f};
+    };
+
+    struct Action {
+        std::string Name;
+        std::vector<InputBinding> Bindings;
+    };
+
     static GLFWwindow* window_;
 
-    static std::unordered_map<int, bool> current_key_states_;
-    static std::unordered_map<int, bool> last_key_states_;
+    // Written by ApplyEvents. The "tapped" bits latch presses, so a key that goes down
+    // and up between two snapshots still shows up as pressed for one frame.
+    static State live_;
+    static std::bitset<kKeyCount> tappedKeys_;
+    static std::bitset<kMouseButtonCount> tappedButtons_;
+
+    static State current_;
+    static State previous_;
+
+    static std::vector<Action> actions_;
+    static std::bitset<kMaxActions> currentActions_;
+    static std::bitset<kMaxActions> previousActions_;
 };
 } // namespace se
@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 #include <engine/Camera.h>
+#include <engine/Event.h>
 #include <glad/glad.h>
 enum class CursorMode {
     Normal = GLFW_CURSOR_NORMAL,
@@ -22,6 +23,8 @@ class InputHandler {
     void processKeyboard(GLFWwindow* window, float deltaTime);
     void processMousePosition(double xpos, double ypos);
     void processMouseScroll(double xpos, double ypos);
+    // Mouse look and zoom from the window's event batch (see Layer::OnEvents)
+    void processEvent(const se::Event& event);
 
   private:
     Camera* camera_ = nullptr;
@@ -31,18 +34,4 @@ class InputHandler {
 
     void setupMouseCapture(GLFWwindow* window);
     void initializeMousePosition(GLFWwindow* window);
-
-    static void mousePositionCallback(GLFWwindow* window, double xpos, double ypos) {
-        auto* handler = static_cast<InputHandler*>(glfwGetWindowUserPointer(window));
-        if (handler) {
-            handler->processMousePosition(xpos, ypos);
-        }
-    }
-
-    static void mouseScrollCallback(GLFWwindow* window, double xpos, double ypos) {
-        auto* handler = static_cast<InputHandler*>(glfwGetWindowUserPointer(window));
-        if (handler) {
-            handler->processMouseScroll(xpos, ypos);
-        }
-    }
 };
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "engine/EventQueue.h"
+#include "engine/Input.h"
+#include <array>
+#include <cstdint>
+#include <glm.hpp>
+#include <string>
+#include <vector>
+
+namespace se {
+
+// Everything the engine reads from input in one frame, plus the frame's timestep
+struct InputFrame {
+    static constexpr uint32_t kKeyBytes = Input::kKeyCount / 8;
+
+    float Timestep = 0.0f;
+    glm::vec2 Cursor{0.0f};
+    glm::vec2 Scroll{0.0f}; // Accumulated over the frame
+    uint8_t MouseButtons = 0;
+    std::array<uint8_t, kKeyBytes> Keys{};
+
+    bool IsKeyDown(int keycode) const {
+        if (keycode < 0 || keycode >= (int)Input::kKeyCount)
+            return false;
+        return (Keys[keycode >> 3] >> (keycode & 7)) & 1;
+    }
+
+    bool IsMouseButtonDown(int button) const {
+        if (button < 0 || button >= (int)Input::kMouseButtonCount)
+            return false;
+        return (MouseButtons >> button) & 1;
+    }
+};
+
+// Captures per-frame input into a compact binary file and plays it back with the recorded
+// timesteps, so the same camera path / key sequence can be rerun across builds and machines.
+//
+// Playback goes through the regular path: recorded changes are pushed into the window's
+// event queue as key/button/mouse events (real input events are discarded), so Input and
+// every layer see them exactly as live input. ImGui does not see replayed input.
+//
+// File layout (native endianness): a 16-byte header ("SEIR", version, frame count), then per
+// frame a flags byte and the timestep, followed only by the parts that changed.
+class InputRecorder {
+  public:
+    ~InputRecorder();
+
+    // Recording is kept in memory and written by Stop(); playback files are loaded whole,
+    // so neither touches the disk while frames are being timed
+    void BeginRecording(const std::string& path);
+    void BeginPlayback(const std::string& path); // Throws if the file can't be read
+
+    void Stop();
+
+    // Recording: store the frame's input snapshot and the `timestep` it runs with
+    // (call after Input::BeginFrame)
+    void CaptureFrame(float timestep);
+    // Playback: push the next recorded frame's input changes into `events` and return its
+    // timestep. Returns false once the recording is exhausted.
+    bool PlaybackFrame(float& timestep, EventQueue& events);
+
+    bool IsRecording() const {
+        return mode_ == Mode::Recording;
+    }
+
+    bool IsReplaying() const {
+        return mode_ == Mode::Playback;
+    }
+
+    uint32_t GetFrameIndex() const {
+        return frameIndex_;
+    }
+
+    uint32_t GetFrameCount() const {
+        return frameCount_;
+    }
+
+  private:
+    enum class Mode { None, Recording, Playback };
+
+    void WriteFile();
+
+  private:
+    Mode mode_ = Mode::None;
+    std::string path_;
+
+    // Encoded frames (without the header)
+    std::vector<uint8_t> data_;
+    size_t readOffset_ = 0;
+    uint32_t frameIndex_ = 0;
+    uint32_t frameCount_ = 0;
+
+    // Last frame written or applied; parts equal to it are not stored again
+    InputFrame previous_;
+};
+
+} // namespace se
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "engine/Event.h"
+#include "engine/EventQueue.h"
 #include <string>
 
 namespace se {
@@ -13,16 +13,29 @@ class Layer {
     virtual void OnAttach() {}
     virtual void OnDetach() {}
     virtual void OnUpdate(float ts) {}
+    // Called zero or more times per frame with a constant timestep (see
+    // ApplicationSpec::FixedUpdateRate), before OnUpdate
+    virtual void OnFixedUpdate(float fixedTs) {}
     virtual void OnRender() {}
     virtual void OnImGuiRender() {}
-    virtual void OnEvent(Event& event) {}
+    // Called once per frame with the events that arrived since the last one, top layer
+    // first. Set Event::Handled to keep an event from the layers below.
+    virtual void OnEvents(EventQueue& events) {}
 
     const std::string& GetName() const {
         return debugName_;
     }
 
+    // The name as a profiler scope label (interned once, at construction)
+    const char* GetProfileName() const {
+        return profileName_;
+    }
+
   protected:
     std::string debugName_;
+
+  private:
+    const char* profileName_;
 };
 
 } // namespace se
\ No newline at end of file
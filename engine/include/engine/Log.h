@@ -1,14 +1,30 @@
 #pragma once
+#include "engine/memory/AllocationTracker.h"
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
 
 namespace se {
+// Lines kept in memory for GetRecentLogLines()
+constexpr size_t kRecentLogLines = 256;
+
 void LogInit(bool toFile = true);
 std::shared_ptr<spdlog::logger>& Logger(); // retorna o logger global
+// The last kRecentLogLines formatted lines, oldest first (for crash/hitch dumps)
+std::vector<std::string> GetRecentLogLines();
 } // namespace se
 
 // macros convenientes
-#define SE_LOG_INFO(...) ::se::Logger()->info(__VA_ARGS__)
-#define SE_LOG_WARN(...) ::se::Logger()->warn(__VA_ARGS__)
-#define SE_LOG_ERROR(...) ::se::Logger()->error(__VA_ARGS__)
-#define SE_LOG_DEBUG(...) ::se::Logger()->debug(__VA_ARGS__)
+#ifdef SE_TRACK_ALLOCATIONS
+// The temporary tag scope lives until the end of the full expression, i.e. the whole call
+#    define SE_LOG_TAGGED(level, ...)                                                              \
+        (::se::AllocationTracker::TagScope(::se::AllocTag::Log), ::se::Logger()->level(__VA_ARGS__))
+#else
+#    define SE_LOG_TAGGED(level, ...) ::se::Logger()->level(__VA_ARGS__)
+#endif
+
+#define SE_LOG_INFO(...) SE_LOG_TAGGED(info, __VA_ARGS__)
+#define SE_LOG_WARN(...) SE_LOG_TAGGED(warn, __VA_ARGS__)
+#define SE_LOG_ERROR(...) SE_LOG_TAGGED(error, __VA_ARGS__)
+#define SE_LOG_DEBUG(...) SE_LOG_TAGGED(debug, __VA_ARGS__)
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace se {
+
+enum class TaskPriority : uint8_t { High = 0, Normal, Low };
+
+// What a task step returns: Continue puts it back in the queue to resume next time
+enum class TaskStatus { Done, Continue };
+
+struct MainThreadQueueStats {
+    uint32_t StepsRun = 0;       // Task steps executed in the last drain
+    uint32_t TasksCompleted = 0; // Tasks that returned Done in the last drain
+    uint32_t Backlog = 0;        // Tasks still waiting after the last drain
+    float TimeMs = 0.0f;         // Time spent draining
+    float BudgetMs = 0.0f;
+};
+
+// Work that must run on the GL/main thread (uploads, shader compiles, entity spawning),
+// spread across frames. Application drains it after OnRender until the frame's budget is
+// used up. Long jobs should be written as resumable tasks that do a small step per call
+// and return Continue.
+class MainThreadQueue {
+  public:
+    using Task = std::function<TaskStatus()>;
+
+    MainThreadQueue();
+    ~MainThreadQueue();
+
+    MainThreadQueue(const MainThreadQueue&) = delete;
+    MainThreadQueue& operator=(const MainThreadQueue&) = delete;
+
+    // Safe from any thread
+    void Enqueue(Task task, TaskPriority priority = TaskPriority::Normal);
+
+    // Per-drain time budget. At least one step runs each drain so work always progresses.
+    void SetBudget(float milliseconds) {
+        budgetMs_ = milliseconds;
+    }
+    float GetBudget() const {
+        return budgetMs_;
+    }
+
+    // Run tasks, highest priority first, until the budget is spent or the queue is empty.
+    // Main thread only.
+    void Drain();
+
+    // Run everything now, ignoring the budget (loading screens, shutdown)
+    void Flush();
+
+    // Drop pending tasks without running them
+    void Clear();
+
+    uint32_t GetBacklog() const;
+
+    const MainThreadQueueStats& GetStats() const {
+        return stats_;
+    }
+
+    // The engine's queue (owned by Application), or nullptr if none exists
+    static MainThreadQueue* Get() {
+        return s_Instance;
+    }
+
+  private:
+    void Run(float budgetMs);
+    bool Pop(Task& task, TaskPriority& priority);
+
+  private:
+    mutable std::mutex mutex_;
+    std::array<std::deque<Task>, 3> queues_; // Indexed by TaskPriority
+    float budgetMs_ = 2.0f;
+    MainThreadQueueStats stats_;
+
+    static MainThreadQueue* s_Instance;
+};
+
+} // namespace se
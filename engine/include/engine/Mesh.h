@@ -13,7 +13,8 @@ class Mesh {
     Mesh& operator=(Mesh&& other) noexcept;
     ~Mesh();
 
-    // Render using legacy OpenGL (for backward compatibility)
+    // Render using legacy OpenGL (for backward compatibility). GL objects are created on
+    // the first draw, so meshes can be built on any thread (e.g. MeshFactory in jobs).
     void draw() const;
 
     // Getters for new renderer architecture
@@ -24,7 +25,7 @@ class Mesh {
         return indices_;
     }
 
-    // Legacy OpenGL getters (if needed)
+    // Legacy OpenGL getters (if needed; 0 until the first draw)
     GLuint getVAO() const {
         return vao_;
     }
@@ -45,12 +46,12 @@ class Mesh {
     }
 
   private:
-    void setupMesh();
+    void setupMesh() const;
 
     std::vector<float> vertices_;
     std::vector<unsigned int> indices_;
 
-    GLuint vao_ = 0;
-    GLuint vbo_ = 0;
-    GLuint ebo_ = 0;
+    mutable GLuint vao_ = 0;
+    mutable GLuint vbo_ = 0;
+    mutable GLuint ebo_ = 0;
 };
@@ -21,6 +21,10 @@ class MeshFactory {
 
     static Mesh CreateCylinder(float radius = 0.5f, float height = 1.0f, int segments = 16);
 
+    // Turn pos+color vertices (6 floats) into pos+color+normal (9 floats), each normal the
+    // normalized sum of its triangles' face normals. Public for the microbenchmarks.
+    static void addNormals(std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+
   private:
     // Helper functions
     static void addVertex(std::vector<float>& vertices, float x, float y, float z, float r, float g,
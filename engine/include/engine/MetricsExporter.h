@@ -0,0 +1,71 @@
+#pragma once
+
+#include "engine/FrameStats.h"
+#include "engine/Window.h"
+#include <cstdint>
+#include <cstdio>
+#include <spdlog/fmt/fmt.h>
+#include <string>
+
+namespace se {
+
+struct MetricsExporterSpec {
+    // File path, or "unix:<path>" to stream to a listening Unix domain socket
+    std::string Output;
+    MetricsFormat Format = MetricsFormat::JsonLines;
+    // Export every Nth frame
+    uint32_t Interval = 1;
+};
+
+// Streams one line of per-frame metrics (frame and phase times, CPU/GPU pass times, render
+// counters, entity count, allocations and resident memory) to a file or a Unix domain
+// socket, for dashboards and soak tests that tail it. Application only creates it when
+// ApplicationSpec::MetricsOutput is set, so a disabled exporter costs one branch.
+//
+// Lines are formatted into a reused buffer on the main thread. Files are flushed once a
+// second. Socket writes never block: a line the reader isn't ready for is dropped and
+// counted, and a closed connection is retried every few seconds.
+class MetricsExporter {
+  public:
+    explicit MetricsExporter(const MetricsExporterSpec& spec);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Called by Application when a frame has ended
+    void AddFrame(const FrameRecord& record);
+
+    uint64_t GetExportedCount() const {
+        return exported_;
+    }
+    // Lines a socket reader wasn't ready for
+    uint64_t GetDroppedCount() const {
+        return dropped_;
+    }
+
+  private:
+    bool Open();
+    void Close();
+    void WriteHeader();
+    // True once the line in buffer_ is written or fully queued in the socket
+    bool Write(bool flush);
+    bool Send(const char* data, size_t size);
+
+  private:
+    MetricsExporterSpec spec_;
+    std::string socketPath_; // Empty when writing to a file
+    std::FILE* file_ = nullptr;
+    int socket_ = -1;
+    int statmFd_ = -1; // /proc/self/statm, kept open for the RSS column
+
+    fmt::memory_buffer buffer_;
+    std::string pendingTail_;
+    uint64_t startNs_ = 0;
+    uint64_t lastFlushNs_ = 0;
+    uint64_t lastConnectNs_ = 0;
+    uint64_t exported_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+} // namespace se
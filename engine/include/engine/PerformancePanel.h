@@ -0,0 +1,61 @@
+#pragma once
+
+#include "engine/FrameStats.h"
+#include "engine/Profiler.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace se {
+
+// Built-in performance overlay (owned by ImGuiLayer, toggled with F3): a scrolling
+// frame-time graph, rolling p50/p95/p99, and a CPU/GPU breakdown per phase, layer and
+// pass. Pausing freezes the history; clicking a frame in the graph drills into it,
+// including the profiler scopes recorded during that frame (SE_PROFILE builds).
+class PerformancePanel {
+  public:
+    static constexpr uint32_t kHistorySize = 512;
+    // Frames averaged for the live breakdown
+    static constexpr uint32_t kAverageFrames = 60;
+
+    PerformancePanel();
+
+    // Ignored while paused
+    void AddFrame(const FrameRecord& record);
+
+    void OnImGuiRender();
+
+    bool IsOpen() const {
+        return open_;
+    }
+    void SetOpen(bool open) {
+        open_ = open;
+    }
+
+  private:
+    // age 0 is the newest frame
+    const FrameRecord& GetFrame(uint32_t age) const;
+    FrameRecord Average(uint32_t frames) const;
+
+    void SelectFrame(uint32_t age);
+    void ClearSelection();
+
+    void DrawFrameGraph();
+    void DrawPercentiles();
+    void DrawBreakdown(const FrameRecord& frame);
+    void DrawScopes(const FrameRecord& frame);
+
+  private:
+    std::vector<FrameRecord> history_;
+    uint32_t head_ = 0; // Next slot to write
+    uint32_t count_ = 0;
+
+    bool open_ = false;
+    bool paused_ = false;
+    int32_t selectedAge_ = -1;
+    std::vector<ProfileThreadCapture> selectedScopes_;
+
+    std::array<float, kHistorySize> sortScratch_{};
+};
+
+} // namespace se
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace se {
+
+struct ProfileEvent {
+    const char* Name;
+    uint64_t Start; // Profiler::Now() timestamps
+    uint64_t End;
+};
+
+// One thread's buffered scopes, in the order they ended
+struct ProfileThreadCapture {
+    uint32_t ThreadId = 0;
+    std::string Name;
+    std::vector<ProfileEvent> Events;
+};
+
+// Scoped CPU profiler. Every SE_PROFILE_SCOPE records a begin/end timestamp pair into a
+// per-thread ring buffer (single writer, no locks on the hot path); the newest
+// kEventsPerThread scopes of each thread are kept. WriteChromeTrace() dumps them as a
+// Chrome trace JSON file that chrome://tracing or ui.perfetto.dev can open.
+//
+// Scope names must outlive the profiler: use string literals or InternName().
+//
+// The macros compile to nothing unless SE_PROFILE is defined (CMake option SE_PROFILE,
+// never in Release builds).
+class Profiler {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t kEventsPerThread = 1u << 16;
+
+    struct Scope {
+        explicit Scope(const char* name) noexcept
+            : name_(name), start_(IsEnabled() ? Now() : 0) {}
+        ~Scope() {
+            if (start_ != 0)
+                Record(name_, start_, Now());
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        const char* name_;
+        uint64_t start_;
+    };
+
+    // Recording is on by default when compiled in
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+    // Label the calling thread in the trace ("Main", "Render", ...)
+    static void SetThreadName(std::string_view name);
+
+    // Returns a pointer that stays valid for the lifetime of the process. Meant for names
+    // built at runtime (layer names); intern once, not per scope.
+    static const char* InternName(std::string_view name);
+
+    // Copy the buffered scopes of every thread that overlap [begin, end). Empty when
+    // profiling is compiled out.
+    static std::vector<ProfileThreadCapture> Capture(uint64_t begin = 0,
+                                                     uint64_t end = UINT64_MAX);
+
+    // Write every buffered scope of every thread. Returns false if the file could not be
+    // written or profiling is compiled out.
+    static bool WriteChromeTrace(const std::string& path);
+    // Write the given scopes (possibly none) plus caller-serialized JSON: extraEvents are
+    // appended to "traceEvents" (comma-separated objects), extraFields to the top-level
+    // object (comma-separated members). Works without SE_PROFILE.
+    static bool WriteChromeTrace(const std::string& path,
+                                 const std::vector<ProfileThreadCapture>& threads,
+                                 std::string_view extraEvents, std::string_view extraFields);
+
+    // Nanoseconds since the profiler's epoch (never 0)
+    static uint64_t Now() noexcept;
+
+    static void Record(const char* name, uint64_t start, uint64_t end) noexcept;
+
+  private:
+    Profiler() = delete;
+};
+
+} // namespace se
+
+#define SE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SE_PROFILE_CONCAT(a, b) SE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef SE_PROFILE
+#    if defined(_MSC_VER)
+#        define SE_PROFILE_FUNCTION_NAME __FUNCSIG__
+#    else
+#        define SE_PROFILE_FUNCTION_NAME __PRETTY_FUNCTION__
+#    endif
+#    define SE_PROFILE_SCOPE(name)                                                               \
+        ::se::Profiler::Scope SE_PROFILE_CONCAT(seProfileScope, __LINE__)(name)
+#    define SE_PROFILE_FUNCTION() SE_PROFILE_SCOPE(SE_PROFILE_FUNCTION_NAME)
+#else
+#    define SE_PROFILE_SCOPE(name)
+#    define SE_PROFILE_FUNCTION()
+#endif
@@ -33,6 +33,14 @@ class Shader {
     void setVec4(const char* name, const glm::vec4& value) const;
     void setMat4(const char* name, const glm::mat4& value) const;
 
+    // Sources the program was built from (kept for frame captures, see FrameCapture)
+    const std::string& getVertexSource() const {
+        return vertexSource_;
+    }
+    const std::string& getFragmentSource() const {
+        return fragmentSource_;
+    }
+
     unsigned int getID() const {
         return program_;
     }
@@ -44,10 +52,11 @@ class Shader {
 
   private:
     unsigned int program_ = 0;
+    std::string vertexSource_;
+    std::string fragmentSource_;
 
     static unsigned int compileStage(unsigned int type, const char* src);
     static void checkCompile(unsigned int id, bool isProgram);
-    int uniformLocation(const char* name) const;
 };
 
 } // namespace se
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace se {
+
+// Collects how long each startup phase took and logs a breakdown once the first frame has
+// been presented (time-to-first-frame).
+class StartupTimer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // Times one phase for as long as it is alive
+    class Scope {
+      public:
+        Scope(StartupTimer& timer, std::string name);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+      private:
+        StartupTimer& timer_;
+        std::string name_;
+        Clock::time_point start_;
+    };
+
+    void Start();
+    void AddPhase(std::string name, float milliseconds);
+
+    // Logs the report; later phases are ignored
+    void Finish();
+
+    bool IsFinished() const {
+        return finished_;
+    }
+
+  private:
+    struct Phase {
+        std::string Name;
+        float Milliseconds;
+    };
+
+    Clock::time_point start_{};
+    std::vector<Phase> phases_;
+    bool finished_ = false;
+};
+
+} // namespace se
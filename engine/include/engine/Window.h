@@ -1,5 +1,7 @@
 #pragma once
 
+#include "engine/EventQueue.h"
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -10,11 +12,94 @@ namespace se {
 
 class GraphicsContext;
 
+enum class RenderMode {
+    Continuous, // Render every frame
+    OnDemand    // Block on events; render only on input or Application::RequestRedraw
+};
+
+enum class MetricsFormat {
+    JsonLines, // One JSON object per line
+    Csv        // Header line, then one row per frame
+};
+
 struct ApplicationSpec {
     std::string Name = "Simple Engine";
     uint32_t WindowWidth = 1280;
     uint32_t WindowHeight = 720;
     bool VSync = true;
+
+    // How many frames the GPU may queue behind the CPU (0 = driver default). Lower values
+    // trade throughput for input latency.
+    uint32_t MaxFramesInFlight = 0;
+    // Poll input again right before rendering so the camera uses the freshest input
+    bool JustInTimeInput = false;
+
+    // Job system workers (0 = hardware threads - 1) and optional core pinning
+    uint32_t WorkerThreads = 0;
+    bool PinWorkerThreads = false;
+
+    // Replay recorded frames on a dedicated render thread that owns the GL context, so
+    // the next frame's simulation overlaps the current frame's GL submission
+    bool RenderThread = false;
+
+    // Initial size of each per-frame arena block (see FrameArena); grows on overflow
+    size_t FrameArenaSize = size_t(4) << 20;
+
+    // Per-frame time the main-thread task queue may use after OnRender
+    float MainThreadBudgetMs = 2.0f;
+
+    RenderMode Mode = RenderMode::Continuous;
+    // OnDemand: longest a single event wait may block, in seconds
+    float IdleWaitTimeout = 0.5f;
+
+    // Frame-rate cap applied when VSync is off (0 = uncapped)
+    float TargetFrameRate = 0.0f;
+    // Keep capped frames evenly spaced (see FrameLimiter::SetPacing)
+    bool FramePacing = true;
+
+    // Rate of Layer::OnFixedUpdate in Hz (0 disables fixed steps)
+    float FixedUpdateRate = 60.0f;
+    // Upper bound of fixed steps per frame; time beyond it is dropped so slow frames
+    // can't snowball into ever more simulation work
+    uint32_t MaxFixedStepsPerFrame = 5;
+
+    // Record per-frame input to this file, or replay a recording with its timesteps
+    // (see InputRecorder). Replay stops the application after the last recorded frame.
+    std::string InputRecordPath;
+    std::string InputReplayPath;
+
+    // Write the profiler's buffered scopes as a Chrome trace when Run() returns (see
+    // Profiler; needs an SE_PROFILE build)
+    std::string ProfileTracePath;
+    // Sample CPU performance counters (perf_event_open) per frame and per counter scope.
+    // Linux only; needs perf_event_paranoid <= 2 and, for most counters, a PMU.
+    bool HardwareCounters = false;
+
+    // Flight recorder (see FlightRecorder): keep the last frames and dump them to
+    // HitchDumpDirectory when a frame's busy time exceeds HitchFactor x the rolling median
+    // (and HitchMinMs)
+    bool FlightRecorder = true;
+    float HitchFactor = 3.0f;
+    float HitchMinMs = 50.0f;
+    std::string HitchDumpDirectory = "logs/hitches";
+
+    // Stream per-frame metrics (see MetricsExporter) to this file, or to a listening Unix
+    // domain socket given as "unix:<path>". Empty disables the exporter.
+    std::string MetricsOutput;
+    MetricsFormat MetricsOutputFormat = MetricsFormat::JsonLines;
+    // Export every Nth frame
+    uint32_t MetricsInterval = 1;
+
+    // Capture the SceneRenderer input of frame CaptureFrame to this file (see FrameCapture;
+    // apps/replay re-renders it). Empty disables the capture.
+    std::string CaptureFramePath;
+    uint32_t CaptureFrame = 0;
+
+    // Headless mode: no visible window, rendering goes into an offscreen framebuffer
+    // (surfaceless EGL when available, OSMesa otherwise). Intended for CI/render-farm boxes.
+    bool Headless = false;
+    // Number of frames to run in headless mode before Run() returns (0 = until Stop())
+    uint32_t HeadlessFrameCount = 0;
 };
 
 class Window {
@@ -25,6 +110,21 @@ class Window {
 
     void OnUpdate(); // Poll events
 
+    // Events delivered by the callbacks since Application last dispatched them
+    EventQueue& GetEvents() {
+        return events_;
+    }
+
+    // GL context ownership for the render thread handoff (see GraphicsContext::MakeCurrent)
+    void MakeContextCurrent();
+    void ReleaseContext();
+
+    // Block until events arrive or the timeout expires. Returns true if a GLFW callback or
+    // PostWakeup ran while waiting, false on timeout.
+    bool WaitEvents(double timeoutSeconds);
+    // Wake a WaitEvents call. Safe from any thread.
+    void PostWakeup();
+
     uint32_t GetWidth() const {
         return width_;
     }
@@ -46,6 +146,10 @@ class Window {
         return vsync_;
     }
 
+    bool IsHeadless() const {
+        return headless_;
+    }
+
     bool ShouldClose() const;
     void RequestClose();
 
@@ -55,20 +159,38 @@ class Window {
 
     void SwapBuffers();
 
+    void SetMaxFramesInFlight(uint32_t frames);
+    float GetLastFenceWaitMs() const;
+
   private:
     void Init(uint32_t width, uint32_t height, const std::string& title);
     void Shutdown();
 
+    // Counts the wakeup WaitEvents reports, then queues the event
+    void PushEvent(const Event& event);
+
+    // GLFW callbacks: they only queue events (or just note the wakeup)
     static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
+    static void WindowCloseCallback(GLFWwindow* window);
+    static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void CursorPosCallback(GLFWwindow* window, double xpos, double ypos);
+    static void ScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+    static void CharCallback(GLFWwindow* window, unsigned int codepoint);
+    static void WindowRefreshCallback(GLFWwindow* window);
 
   private:
     GLFWwindow* handle_ = nullptr;
     std::unique_ptr<GraphicsContext> context_;
+    EventQueue events_;
+    // Bumped by every callback and PostWakeup; WaitEvents compares it before and after
+    std::atomic<uint32_t> wakeups_{0};
 
     uint32_t width_;
     uint32_t height_;
     std::string title_;
     bool vsync_ = true;
+    bool headless_ = false;
 };
 
 } // namespace se
\ No newline at end of file
@@ -75,6 +75,32 @@ struct TransformComponent {
     }
 };
 
+// ==================== Previous Transform Component ====================
+// Transform captured at the start of the last fixed step. RenderSystem blends it with
+// TransformComponent using the application's interpolation alpha.
+struct PreviousTransformComponent {
+    glm::vec3 Position = {0.0f, 0.0f, 0.0f};
+    glm::vec3 Rotation = {0.0f, 0.0f, 0.0f};
+    glm::vec3 Scale = {1.0f, 1.0f, 1.0f};
+
+    PreviousTransformComponent() = default;
+
+    PreviousTransformComponent(const PreviousTransformComponent&) = default;
+
+    PreviousTransformComponent(const TransformComponent& transform)
+        : Position(transform.Position), Rotation(transform.Rotation), Scale(transform.Scale) {}
+
+    // Blend towards the current transform and build the matrix
+    glm::mat4 Interpolate(const TransformComponent& current, float alpha) const {
+        glm::vec3 position = glm::mix(Position, current.Position, alpha);
+        glm::vec3 scale = glm::mix(Scale, current.Scale, alpha);
+        glm::quat rotation = glm::slerp(glm::quat(glm::radians(Rotation)),
+                                        glm::quat(glm::radians(current.Rotation)), alpha);
+        return glm::translate(glm::mat4(1.0f), position) * glm::toMat4(rotation) *
+               glm::scale(glm::mat4(1.0f), scale);
+    }
+};
+
 // ==================== Name Component ====================
 // Gives each entity a human-readable name
 struct NameComponent {
@@ -14,8 +14,11 @@ class RenderSystem {
     static void Init();
     static void Shutdown();
 
-    // Render all entities with MeshRenderComponent in the scene
-    static void Render(Scene& scene, const Camera& camera, float aspectRatio);
+    // Render all entities with MeshRenderComponent in the scene. Entities that have a
+    // PreviousTransformComponent are blended towards their current transform by
+    // interpolationAlpha.
+    static void Render(Scene& scene, const Camera& camera, float aspectRatio,
+                       float interpolationAlpha = 1.0f);
 
   private:
     RenderSystem() = delete;
@@ -4,13 +4,23 @@
 #include "engine/Camera.h"
 #include "engine/Log.h"
 #include "engine/ecs/Entity.h"
+#include <cstdint>
 #include <entt.hpp>
+#include <functional>
+#include <span>
 #include <string>
 
 namespace se {
 
+class JobSystem;
+
+// Scene logic builds into simple_engine_core, which has no GL/GLFW dependency; only
+// OnRender needs the full engine (it is defined next to RenderSystem).
 class Scene {
   public:
+    // Game logic run on a scene each simulation step
+    using SystemFn = std::function<void(Scene&, float)>;
+
     Scene(const std::string& name = "Untitled Scene");
     ~Scene();
 
@@ -37,8 +47,24 @@ class Scene {
     // Update scene (can be used for systems)
     void OnUpdate(float deltaTime);
 
-    // Render scene (automatically renders all MeshRenderComponents)
-    void OnRender(const Camera& camera, float aspectRatio);
+    // Fixed-rate step. Call it before moving entities in a fixed step: it stores the
+    // pre-step transforms that rendering interpolates from.
+    void OnFixedUpdate(float fixedDeltaTime);
+
+    // One render-free simulation step: OnFixedUpdate, `system`, then OnUpdate
+    void Step(float fixedDeltaTime, const SystemFn& system = {});
+
+    // Advance independent scenes by `steps` fixed steps each, spread across the job
+    // system's workers. A scene is only ever touched by one thread, so systems may use it
+    // freely but must not share mutable state between scenes. Blocks until all are done.
+    static void StepParallel(std::span<Scene* const> scenes, float fixedDeltaTime,
+                             uint32_t steps, JobSystem& jobs, const SystemFn& system = {});
+
+    // Render scene (automatically renders all MeshRenderComponents).
+    // interpolationAlpha blends from the previous fixed step to the current state.
+    // Defined in simple_engine (RenderSystem.cpp), not simple_engine_core: targets that
+    // only link the core library must not call it.
+    void OnRender(const Camera& camera, float aspectRatio, float interpolationAlpha = 1.0f);
 
     // Clear all entities
     void Clear();
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace se {
+
+// Tracks a group of jobs. Schedule() increments it, each finished job decrements it;
+// WaitForCounter() returns once it reaches zero.
+struct JobCounter {
+    std::atomic<uint32_t> Pending{0};
+
+    bool IsDone() const {
+        return Pending.load(std::memory_order_acquire) == 0;
+    }
+};
+
+struct JobSystemSpec {
+    // 0 = one worker per hardware thread, minus the main thread (at least one)
+    uint32_t WorkerCount = 0;
+    // Pin worker i to core (FirstCore + i) % cores. Linux only, ignored elsewhere.
+    bool PinWorkers = false;
+    uint32_t FirstCore = 1;
+};
+
+// Work-stealing thread pool. Every worker owns a deque: it pushes and pops its own jobs
+// at the back (LIFO, cache-warm) and idle workers steal from the front of the others.
+// Threads that are not workers (main thread) schedule into a shared injection queue.
+class JobSystem {
+  public:
+    using Job = std::function<void()>;
+    // Called with a [begin, end) sub-range
+    using RangeJob = std::function<void(uint32_t, uint32_t)>;
+
+    explicit JobSystem(const JobSystemSpec& spec = {});
+    // Runs every job still queued before returning
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Queue a job. If a counter is given it is incremented now and decremented when the
+    // job has run.
+    void Schedule(Job job, JobCounter* counter = nullptr);
+
+    // Run body over [0, count) in batches of batchSize and wait for all of them. The
+    // calling thread works on batches too.
+    void ParallelFor(uint32_t count, uint32_t batchSize, const RangeJob& body);
+
+    // Block until the counter reaches zero, running queued jobs in the meantime
+    void WaitForCounter(JobCounter& counter);
+
+    uint32_t GetWorkerCount() const {
+        return static_cast<uint32_t>(workers_.size());
+    }
+
+    // The engine's job system (owned by Application), or nullptr if none exists
+    static JobSystem* Get() {
+        return s_Instance;
+    }
+
+  private:
+    struct QueuedJob {
+        Job Function;
+        JobCounter* Counter = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex Mutex;
+        std::deque<QueuedJob> Jobs;
+    };
+
+    void WorkerLoop(uint32_t workerIndex);
+    bool TryRunJob(uint32_t queueIndex);
+    bool PopOwn(uint32_t queueIndex, QueuedJob& job);
+    bool Steal(uint32_t thiefIndex, QueuedJob& job);
+    void Execute(QueuedJob& job);
+    uint32_t CurrentQueueIndex() const;
+
+  private:
+    std::vector<std::thread> workers_;
+    // One queue per worker plus the injection queue (last) for non-worker threads
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeCondition_;
+    std::atomic<uint32_t> queuedJobs_{0};
+    std::atomic<bool> stopping_{false};
+
+    static JobSystem* s_Instance;
+};
+
+} // namespace se
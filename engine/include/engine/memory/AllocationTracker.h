@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace se {
+
+// Subsystem an allocation is charged to: the innermost SE_ALLOC_TAG on the allocating thread
+enum class AllocTag : uint8_t { Untagged, Render, Ecs, Resources, UI, Log, Count };
+
+constexpr size_t kAllocTagCount = static_cast<size_t>(AllocTag::Count);
+
+struct AllocationCounters {
+    uint64_t Count = 0;
+    uint64_t Bytes = 0;
+};
+
+struct AllocationFrameStats {
+    uint64_t Frame = 0;
+    std::array<AllocationCounters, kAllocTagCount> Tags{};
+    uint64_t Frees = 0;
+    // Allocations made inside an SE_ZERO_ALLOC_SCOPE
+    uint64_t ZeroAllocViolations = 0;
+
+    AllocationCounters Total() const;
+};
+
+enum class ZeroAllocMode : uint8_t {
+    Off,
+    Report, // Count violations and log the offending regions at the end of the frame
+    Abort   // Print the region to stderr and abort on the spot (run under a debugger)
+};
+
+// Counts every C++ heap allocation (global operator new/delete) per subsystem tag and per
+// frame. Only compiled in with the CMake option SE_TRACK_ALLOCATIONS, which replaces the
+// global operators; otherwise the macros are empty and every frame reports zeros.
+// Allocations made through malloc (drivers, C libraries) are not seen.
+//
+// Zero-alloc scopes mark code that must not allocate once the engine has warmed up. The
+// first kWarmupFrames frames are exempt, so buffers and arenas can reach their
+// steady-state size first.
+class AllocationTracker {
+  public:
+    static constexpr uint64_t kWarmupFrames = 120;
+
+    // Restores the previous tag on destruction
+    class TagScope {
+      public:
+        explicit TagScope(AllocTag tag) noexcept : previous_(SetThreadTag(tag)) {}
+        ~TagScope() {
+            SetThreadTag(previous_);
+        }
+
+        TagScope(const TagScope&) = delete;
+        TagScope& operator=(const TagScope&) = delete;
+
+      private:
+        AllocTag previous_;
+    };
+
+    class ZeroAllocScope {
+      public:
+        explicit ZeroAllocScope(const char* name) noexcept : previous_(SetZeroAllocRegion(name)) {}
+        ~ZeroAllocScope() {
+            SetZeroAllocRegion(previous_);
+        }
+
+        ZeroAllocScope(const ZeroAllocScope&) = delete;
+        ZeroAllocScope& operator=(const ZeroAllocScope&) = delete;
+
+      private:
+        const char* previous_;
+    };
+
+    static constexpr bool IsCompiledIn() {
+#ifdef SE_TRACK_ALLOCATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Report by default
+    static void SetZeroAllocMode(ZeroAllocMode mode);
+    static ZeroAllocMode GetZeroAllocMode();
+
+    // Closes the frame: snapshots the counters and logs zero-alloc violations. Called by
+    // Application once per frame.
+    static void EndFrame();
+
+    // Last completed frame
+    static AllocationFrameStats GetLastFrame();
+    // Everything since startup
+    static AllocationFrameStats GetTotals();
+
+    static const char* GetTagName(AllocTag tag);
+
+    // Return the previous value; used by the scopes
+    static AllocTag SetThreadTag(AllocTag tag) noexcept;
+    static const char* SetZeroAllocRegion(const char* name) noexcept;
+
+  private:
+    AllocationTracker() = delete;
+};
+
+} // namespace se
+
+#ifdef SE_TRACK_ALLOCATIONS
+#    define SE_ALLOC_TAG(tag)                                                                      \
+        ::se::AllocationTracker::TagScope SE_ALLOC_CONCAT(seAllocTag, __LINE__)(::se::AllocTag::tag)
+#    define SE_ZERO_ALLOC_SCOPE(name)                                                              \
+        ::se::AllocationTracker::ZeroAllocScope SE_ALLOC_CONCAT(seZeroAlloc, __LINE__)(name)
+#else
+#    define SE_ALLOC_TAG(tag)
+#    define SE_ZERO_ALLOC_SCOPE(name)
+#endif
+
+#define SE_ALLOC_CONCAT_IMPL(a, b) a##b
+#define SE_ALLOC_CONCAT(a, b) SE_ALLOC_CONCAT_IMPL(a, b)
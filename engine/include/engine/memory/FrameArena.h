@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace se {
+
+struct FrameArenaStats {
+    size_t UsedBytes = 0;     // Bump-allocated in the current frame so far
+    size_t CapacityBytes = 0; // Size of the current frame's block
+    size_t OverflowBytes = 0; // Served from the heap because the block was full
+    size_t PeakBytes = 0;     // Highest per-frame total seen
+};
+
+// Per-frame bump allocator for transient data (render submissions, scratch arrays, ImGui
+// strings). Memory is never freed individually: BeginFrame() rewinds the oldest of the
+// N blocks, so an allocation stays valid for N - 1 further frames (long enough for the
+// render thread to consume what the main thread recorded).
+//
+// Allocating is a lock-free pointer bump and safe from jobs. When a block runs out the
+// rest of the frame falls back to the heap, and the block is grown at its next reset, so a
+// steady-state frame ends up doing no heap allocations at all.
+//
+// Nothing allocated here has its destructor run; containers using FrameAllocator must be
+// destroyed (or cleared) before the block is rewound.
+class FrameArena {
+  public:
+    static constexpr uint32_t kMaxFrames = 3;
+
+    explicit FrameArena(size_t bytesPerFrame = size_t(4) << 20, uint32_t frameCount = 2);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Switch to the next block and rewind it. Called by Application at frame start.
+    void BeginFrame();
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    FrameArenaStats GetStats() const;
+
+    uint32_t GetFrameCount() const {
+        return frameCount_;
+    }
+
+    // The arena Application owns, or null outside of an application
+    static FrameArena* Get();
+
+  private:
+    struct Overflow {
+        void* Pointer;
+        size_t Alignment;
+    };
+
+    struct Block {
+        std::byte* Data = nullptr;
+        size_t Capacity = 0;
+        std::atomic<size_t> Offset{0};
+        std::vector<Overflow> Overflows;
+        size_t OverflowBytes = 0;
+    };
+
+    void* AllocateOverflow(Block& block, size_t size, size_t alignment);
+    void Rewind(Block& block);
+
+  private:
+    std::array<Block, kMaxFrames> blocks_;
+    uint32_t frameCount_ = 2;
+    uint32_t current_ = 0;
+    size_t peakBytes_ = 0;
+    std::mutex overflowMutex_;
+
+    static FrameArena* s_Instance;
+};
+
+// STL allocator over a FrameArena. Deallocation is a no-op. Without an arena (tools, tests,
+// code running before Application exists) it falls back to the heap.
+template <typename T>
+class FrameAllocator {
+  public:
+    using value_type = T;
+    // Containers take the arena along when moved/copied/swapped
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    FrameAllocator() noexcept : arena_(FrameArena::Get()) {}
+    explicit FrameAllocator(FrameArena* arena) noexcept : arena_(arena) {}
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept : arena_(other.GetArena()) {}
+
+    T* allocate(size_t count) {
+        if (arena_)
+            return arena_->AllocateArray<T>(count);
+        return static_cast<T*>(::operator new(sizeof(T) * count, std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        if (!arena_)
+            ::operator delete(pointer, std::align_val_t(alignof(T)));
+    }
+
+    FrameArena* GetArena() const noexcept {
+        return arena_;
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const noexcept {
+        return arena_ == other.GetArena();
+    }
+
+  private:
+    FrameArena* arena_;
+};
+
+// Transient vector for the current frame
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace se
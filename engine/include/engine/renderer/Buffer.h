@@ -38,6 +38,7 @@ class BufferLayout {
   public:
     BufferLayout() = default;
     BufferLayout(const std::initializer_list<BufferElement>& elements);
+    explicit BufferLayout(std::vector<BufferElement> elements);
 
     uint32_t GetStride() const {
         return stride_;
@@ -85,6 +86,9 @@ class VertexBuffer {
     void SetLayout(const BufferLayout& layout) {
         layout_ = layout;
     }
+    uint32_t GetRendererID() const {
+        return rendererId_;
+    }
 
   private:
     uint32_t rendererId_;
@@ -103,6 +107,9 @@ class IndexBuffer {
     uint32_t GetCount() const {
         return count_;
     }
+    uint32_t GetRendererID() const {
+        return rendererId_;
+    }
 
   private:
     uint32_t rendererId_;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "engine/renderer/Buffer.h"
+#include "engine/renderer/SceneRenderer.h"
+#include <cstdint>
+#include <filesystem>
+#include <glm.hpp>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace se {
+
+struct CapturedVertexBuffer {
+    // Name, type and normalization per attribute; offsets and stride are recomputed
+    std::vector<BufferElement> Layout;
+    std::vector<uint8_t> Data;
+};
+
+struct CapturedMesh {
+    std::vector<CapturedVertexBuffer> VertexBuffers;
+    std::vector<uint32_t> Indices;
+};
+
+struct CapturedShader {
+    std::string VertexSource;
+    std::string FragmentSource;
+};
+
+struct CapturedMaterial {
+    uint32_t Shader = 0; // Index into CapturedFrame::Shaders
+    std::vector<std::pair<std::string, float>> Floats;
+    std::vector<std::pair<std::string, int>> Ints;
+    std::vector<std::pair<std::string, glm::vec3>> Vector3s;
+    std::vector<std::pair<std::string, glm::vec4>> Vector4s;
+    std::vector<std::pair<std::string, glm::mat4>> Matrix4s;
+};
+
+struct CapturedSubmission {
+    // Material of a submission that only feeds the shadow pass
+    static constexpr uint32_t kNoMaterial = 0xFFFFFFFF;
+
+    uint32_t Mesh = 0;     // Index into CapturedFrame::Meshes
+    uint32_t Material = 0; // Index into CapturedFrame::Materials, or kNoMaterial
+    glm::mat4 Transform{1.0f};
+    bool CastsShadows = true;
+    bool ReceiveShadows = true;
+};
+
+// Everything one SceneRenderer scene was given: the BeginScene matrices, the directional
+// light, every submission in order, and the meshes, materials and shaders they reference
+// (each stored once). Enough to re-render the scene without the application that built it.
+struct CapturedFrame {
+    glm::mat4 ViewMatrix{1.0f};
+    glm::mat4 ProjectionMatrix{1.0f};
+    SceneRenderer::DirectionalLightData DirectionalLight;
+    // Viewport the scene was rendered into
+    glm::ivec2 ViewportSize{0, 0};
+
+    std::vector<CapturedShader> Shaders;
+    std::vector<CapturedMaterial> Materials;
+    std::vector<CapturedMesh> Meshes;
+    std::vector<CapturedSubmission> Submissions;
+};
+
+// Binary (native-endian) serialization of a CapturedFrame. SceneRenderer::CaptureNextScene
+// produces the files; apps/replay renders them in a loop.
+class FrameCapture {
+  public:
+    static bool Save(const CapturedFrame& frame, const std::filesystem::path& path);
+    // Empty if the file is missing, truncated or from another format version
+    static std::optional<CapturedFrame> Load(const std::filesystem::path& path);
+
+    // Copy a mesh's buffers back from GL. Needs the GL context current on the calling thread.
+    static CapturedMesh ReadBack(const VertexArray& vertexArray);
+};
+
+} // namespace se
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace se {
+
+enum class GpuPass : uint8_t { Shadow, Scene, ImGui, Count };
+
+constexpr size_t kGpuPassCount = static_cast<size_t>(GpuPass::Count);
+
+struct GpuPassStats {
+    float Milliseconds = 0.0f;
+    // Pipeline statistics; zero unless enabled and supported by the driver
+    uint64_t VerticesSubmitted = 0;
+    uint64_t PrimitivesSubmitted = 0;
+    uint64_t FragmentInvocations = 0;
+};
+
+using GpuFrameStats = std::array<GpuPassStats, kGpuPassCount>;
+
+// GPU timings per render pass from GL_TIME_ELAPSED queries, plus optional
+// ARB_pipeline_statistics_query counters. Begin/End are recorded as RenderCommand
+// callbacks, so the queries run on whichever thread executes the frame. Results are read
+// kFrameLatency frames later and only if the driver already has them: a frame whose
+// queries aren't ready is dropped rather than stalling the pipeline.
+class GpuProfiler {
+  public:
+    static constexpr uint32_t kFrameLatency = 4;
+    // A pass issued more often per frame (several scenes) is only timed this many times
+    static constexpr uint32_t kMaxQueriesPerPass = 4;
+
+    // Called by Renderer at the start of every frame
+    static void BeginFrame();
+
+    // Also routes RenderCounters to the pass
+    static void BeginPass(GpuPass pass);
+    static void EndPass(GpuPass pass);
+
+    // Off by default: the counters cost some GPU time on most drivers
+    static void SetPipelineStatistics(bool enabled);
+    static bool IsPipelineStatisticsEnabled();
+    // Known once the first frame has executed
+    static bool IsPipelineStatisticsSupported();
+
+    // Latest frame whose queries completed (kFrameLatency or more frames old)
+    static GpuFrameStats GetResults();
+    // Frames whose results were still pending when their queries were reused
+    static uint64_t GetDroppedFrameCount();
+
+    static const char* GetPassName(GpuPass pass);
+
+    // Deletes the query objects. Needs the GL context current.
+    static void Shutdown();
+
+  private:
+    GpuProfiler() = delete;
+};
+
+} // namespace se
@@ -1,22 +1,71 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+
 struct GLFWwindow;
 
 namespace se {
 
 class GraphicsContext {
   public:
-    GraphicsContext(GLFWwindow* windowHandle);
+    // When surfaceless is set the context is created through EGL without any drawable;
+    // the window handle is only kept for input/event queries.
+    GraphicsContext(GLFWwindow* windowHandle, bool surfaceless = false);
     ~GraphicsContext();
 
     void Init();
+
+    // Move the context between threads (render thread handoff). A context can be current
+    // on one thread at a time, so release it before making it current elsewhere.
+    void MakeCurrent();
+    void ReleaseCurrent();
+    // Presents and, when a frames-in-flight limit is set, blocks until the GPU is at most
+    // that many frames behind (fence per presented frame)
     void SwapBuffers();
+
+    // 0 leaves queueing to the driver; otherwise clamped to [1, kMaxFramesInFlight]
+    void SetMaxFramesInFlight(uint32_t frames);
+    uint32_t GetMaxFramesInFlight() const {
+        return maxFramesInFlight_;
+    }
+
+    // Time the last SwapBuffers spent waiting on frame fences. Written by the thread that
+    // presents (the render thread, if any), read by the main thread.
+    float GetLastFenceWaitMs() const {
+        return lastFenceWaitMs_.load(std::memory_order_relaxed);
+    }
+
+    static constexpr uint32_t kMaxFramesInFlight = 8;
+    // 100 ms waits on one fence before it is dropped as never going to signal
+    static constexpr uint32_t kMaxFenceWaitSlices = 20;
     GLFWwindow* GetContext() {
         return windowHandle_;
     }
 
+    bool IsSurfaceless() const {
+        return surfaceless_;
+    }
+
+  private:
+    void InitSurfaceless();
+    void ThrottleFramesInFlight();
+
   private:
     GLFWwindow* windowHandle_;
+    bool surfaceless_ = false;
+
+    // EGLDisplay / EGLContext, kept opaque so EGL headers don't leak into the engine
+    void* eglDisplay_ = nullptr;
+    void* eglContext_ = nullptr;
+
+    // Ring of GLsync fences, one per frame still owned by the GPU
+    std::array<void*, kMaxFramesInFlight> frameFences_{};
+    uint32_t fenceHead_ = 0;
+    uint32_t fenceCount_ = 0;
+    uint32_t maxFramesInFlight_ = 0;
+    std::atomic<float> lastFenceWaitMs_{0.0f};
 };
 
 } // namespace se
\ No newline at end of file
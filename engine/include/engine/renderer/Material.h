@@ -25,6 +25,22 @@ class Material {
         return shader_;
     }
 
+    const std::unordered_map<std::string, float>& GetFloats() const {
+        return floatUniforms_;
+    }
+    const std::unordered_map<std::string, int>& GetInts() const {
+        return intUniforms_;
+    }
+    const std::unordered_map<std::string, glm::vec3>& GetVector3s() const {
+        return vec3Uniforms_;
+    }
+    const std::unordered_map<std::string, glm::vec4>& GetVector4s() const {
+        return vec4Uniforms_;
+    }
+    const std::unordered_map<std::string, glm::mat4>& GetMatrix4s() const {
+        return mat4Uniforms_;
+    }
+
   private:
     std::shared_ptr<Shader> shader_;
     std::unordered_map<std::string, float> floatUniforms_;
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <glm.hpp>
+#include <memory>
 
 namespace se {
 
 class VertexArray;
+class RenderCommandBuffer;
+
+enum class CullFaceMode : uint8_t { Back, Front };
 
 class RenderCommand {
   public:
@@ -12,6 +16,7 @@ class RenderCommand {
     static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     static void SetClearColor(const glm::vec4& color);
     static void Clear();
+    static void ClearDepth();
 
     static void DrawIndexed(const VertexArray* vertexArray, uint32_t indexCount = 0);
     static void DrawArrays(const VertexArray* vertexArray, uint32_t vertexCount);
@@ -19,10 +24,45 @@ class RenderCommand {
     static void SetDepthTest(bool enabled);
     static void SetBlend(bool enabled);
     static void SetCullFace(bool enabled);
+    static void SetCullFaceMode(CullFaceMode mode);
     static void SetWireframe(bool enabled);
 
+    static void BindFramebuffer(uint32_t framebuffer);
+    // texture 0 unbinds the slot
+    static void BindTexture2D(uint32_t slot, uint32_t texture);
+
+    // Used by Shader; uniforms are looked up by name on the executing thread
+    static void UseProgram(uint32_t program);
+    static void SetUniform(uint32_t program, const char* name, float value);
+    static void SetUniform(uint32_t program, const char* name, int value);
+    static void SetUniform(uint32_t program, const char* name, const glm::vec3& value);
+    static void SetUniform(uint32_t program, const char* name, const glm::vec4& value);
+    static void SetUniform(uint32_t program, const char* name, const glm::mat4& value);
+
+    // Run a function on the thread that executes the commands (e.g. ImGui draw data)
+    static void Callback(void (*function)(void*), void* userData);
+
+    // Keep a resource alive until the recorded commands have executed (no-op when
+    // commands execute immediately)
+    static void Retain(std::shared_ptr<const void> resource);
+
+    // Last state set through RenderCommand, in submission order. Lets passes save and
+    // restore state without querying GL (which recorded commands can't do).
+    static glm::ivec4 GetViewport();
+    static uint32_t GetFramebuffer();
+    static bool IsCullFaceEnabled();
+    static CullFaceMode GetCullFaceMode();
+
+    // While a target is set, every command above is appended to it instead of issued to
+    // GL. Main thread only.
+    static void SetRecordTarget(RenderCommandBuffer* buffer);
+    static bool IsRecording();
+
+    // Issue the recorded commands. Needs the GL context current on the calling thread.
+    static void Execute(const RenderCommandBuffer& buffer);
+
   private:
     RenderCommand() = delete;
 };
 
-} // namespace se
\ No newline at end of file
+} // namespace se
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace se {
+
+enum class RenderCommandType : uint16_t {
+    SetViewport,
+    SetClearColor,
+    Clear,
+    ClearDepth,
+    DrawIndexed,
+    DrawArrays,
+    SetDepthTest,
+    SetBlend,
+    SetCullFace,
+    SetCullFaceMode,
+    SetWireframe,
+    BindFramebuffer,
+    BindTexture2D,
+    UseProgram,
+    SetUniformFloat,
+    SetUniformInt,
+    SetUniformVec3,
+    SetUniformVec4,
+    SetUniformMat4,
+    Callback
+};
+
+// Compact byte stream of recorded RenderCommand calls: each command is a header followed
+// by a trivially copyable payload (plus optional inline bytes, e.g. a uniform name).
+// Reset() keeps the capacity, so after the first frames recording does not allocate.
+class RenderCommandBuffer {
+  public:
+    struct Header {
+        RenderCommandType Type;
+        uint16_t Reserved = 0;
+        uint32_t Size; // Payload + extra bytes, excluding the header
+    };
+
+    template <typename T>
+    void Push(RenderCommandType type, const T& payload, const void* extra = nullptr,
+              uint32_t extraSize = 0) {
+        static_assert(std::is_trivially_copyable<T>::value, "Payload must be POD");
+        Header header{type, 0, static_cast<uint32_t>(sizeof(T)) + extraSize};
+
+        size_t offset = data_.size();
+        data_.resize(offset + sizeof(Header) + header.Size);
+        std::memcpy(data_.data() + offset, &header, sizeof(Header));
+        std::memcpy(data_.data() + offset + sizeof(Header), &payload, sizeof(T));
+        if (extraSize)
+            std::memcpy(data_.data() + offset + sizeof(Header) + sizeof(T), extra, extraSize);
+        commandCount_++;
+    }
+
+    // Keep a GPU resource alive until the buffer is reset, i.e. after it has executed
+    void Retain(std::shared_ptr<const void> resource) {
+        retained_.push_back(std::move(resource));
+    }
+
+    // Drops the commands and retained resources (with the GL context current, since that
+    // can delete GL objects)
+    void Reset() {
+        data_.clear();
+        retained_.clear();
+        commandCount_ = 0;
+    }
+
+    const uint8_t* GetData() const {
+        return data_.data();
+    }
+    size_t GetSize() const {
+        return data_.size();
+    }
+    uint32_t GetCommandCount() const {
+        return commandCount_;
+    }
+    bool IsEmpty() const {
+        return commandCount_ == 0;
+    }
+
+  private:
+    std::vector<uint8_t> data_;
+    std::vector<std::shared_ptr<const void>> retained_;
+    uint32_t commandCount_ = 0;
+};
+
+} // namespace se
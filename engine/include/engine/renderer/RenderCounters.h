@@ -0,0 +1,95 @@
+#pragma once
+
+#include "engine/renderer/GpuProfiler.h"
+#include <array>
+#include <cstdint>
+
+namespace se {
+
+// What a pass asked of the driver, counted when the work is submitted (recorded or
+// issued), not when the render thread executes it
+struct PassCounters {
+    uint32_t DrawCalls = 0;
+    uint32_t Triangles = 0;
+    uint32_t ProgramBinds = 0;
+    uint32_t VertexArrayBinds = 0;
+    uint32_t TextureBinds = 0;
+    uint32_t FramebufferBinds = 0;
+    uint32_t UniformUploads = 0;
+    uint32_t UniformBytes = 0;
+    uint32_t BufferUploads = 0;
+    uint64_t BufferBytes = 0;
+
+    PassCounters& operator+=(const PassCounters& other);
+};
+
+// Slot for work submitted outside any GpuPass (clears, resource uploads, blits)
+constexpr size_t kUnscopedPass = kGpuPassCount;
+constexpr size_t kCounterPassCount = kGpuPassCount + 1;
+
+struct FrameCounters {
+    uint64_t Frame = 0;
+    std::array<PassCounters, kCounterPassCount> Passes{};
+    // Objects handed to SceneRenderer versus rejected before submission
+    uint32_t ObjectsSubmitted = 0;
+    uint32_t ObjectsCulled = 0;
+    // Alive entities of the scenes rendered this frame
+    uint32_t Entities = 0;
+
+    const PassCounters& Pass(GpuPass pass) const {
+        return Passes[static_cast<size_t>(pass)];
+    }
+    PassCounters Total() const;
+};
+
+// Per-pass submission counters. RenderCommand (and through it Shader), the buffer classes
+// and the passes bump the counters of the pass GpuProfiler last marked as begun; Application
+// closes the frame with EndFrame() and the last kHistorySize frames are kept.
+//
+// Main thread only, like the rest of submission; a counter bump is one increment.
+class RenderCounters {
+  public:
+    static constexpr uint32_t kHistorySize = 300;
+
+    // Driven by GpuProfiler::BeginPass/EndPass, so timings and counters share pass bounds
+    static void BeginPass(GpuPass pass);
+    static void EndPass();
+
+    // Counters of the active pass in the frame being built
+    static PassCounters& Active() {
+        return *active_;
+    }
+
+    static void AddSubmitted(uint32_t count = 1) {
+        current_.ObjectsSubmitted += count;
+    }
+    static void AddCulled(uint32_t count = 1) {
+        current_.ObjectsCulled += count;
+    }
+    static void AddEntities(uint32_t count) {
+        current_.Entities += count;
+    }
+    static void AddBufferUpload(uint64_t bytes) {
+        active_->BufferUploads++;
+        active_->BufferBytes += bytes;
+    }
+
+    // Pushes the frame into the history and starts the next one
+    static void EndFrame();
+
+    // Last completed frame (all zeros before the first)
+    static const FrameCounters& GetLastFrame();
+    // age 0 is the last completed frame; age must be below GetHistoryCount()
+    static const FrameCounters& GetHistory(uint32_t age);
+    static uint32_t GetHistoryCount();
+
+    static const char* GetPassName(size_t pass);
+
+  private:
+    RenderCounters() = delete;
+
+    static FrameCounters current_;
+    static PassCounters* active_;
+};
+
+} // namespace se
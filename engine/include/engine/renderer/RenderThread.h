@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace se {
+
+class Window;
+class RenderCommandBuffer;
+
+// Replays recorded RenderCommandBuffers and presents them on a dedicated thread. The GL
+// context moves between threads: the render thread holds it while executing a frame and
+// releases it when done, so the main thread can take it for short sync points (uploads)
+// between WaitIdle() and the next Submit().
+class RenderThread {
+  public:
+    explicit RenderThread(Window& window);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // The caller must not have the context current afterwards (Start releases it)
+    void Start();
+    // Waits for the last frame, joins and makes the context current on the caller again
+    void Stop();
+
+    // Execute and present the buffer. The buffer must stay untouched until WaitIdle()
+    // returns; call WaitIdle() before submitting the next one.
+    void Submit(const RenderCommandBuffer& buffer);
+    void WaitIdle();
+
+    bool IsRunning() const {
+        return thread_.joinable();
+    }
+
+    // Render-thread time of the last frame (execute + present)
+    float GetLastFrameMs() const {
+        return lastFrameMs_;
+    }
+
+  private:
+    void ThreadLoop();
+
+  private:
+    Window& window_;
+    std::thread thread_;
+
+    std::mutex mutex_;
+    std::condition_variable workReady_;
+    std::condition_variable workDone_;
+    const RenderCommandBuffer* pending_ = nullptr;
+    bool busy_ = false;
+    bool stopping_ = false;
+
+    float lastFrameMs_ = 0.0f;
+};
+
+} // namespace se
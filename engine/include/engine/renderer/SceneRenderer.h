@@ -1,20 +1,41 @@
 #pragma once
 
 #include "engine/Camera.h"
+#include "engine/memory/FrameArena.h"
+#include "engine/renderer/GpuProfiler.h"
 #include "engine/renderer/Material.h"
+#include "engine/renderer/RenderCounters.h"
 #include "engine/renderer/VertexArray.h"
+#include <filesystem>
 #include <glm.hpp>
 #include <memory>
 #include <vector>
 
 namespace se {
     struct RenderStats {
+        // Shadow and scene pass draws of the last scene
         uint32_t DrawCalls = 0;
         uint32_t TriangleCount = 0;
+        // CPU time spent recording/issuing each pass
+        float ShadowPassMs = 0.0f;
+        float ScenePassMs = 0.0f;
+
+        // Frame latency, written by Application after present. Not cleared by Reset(),
+        // which runs per scene, so the values stay readable during the next frame.
+        float InputToSubmitMs = 0.0f; // last input poll -> SwapBuffers
+        float FenceWaitMs = 0.0f;     // CPU time blocked on frames-in-flight fences
+
+        // GPU time (and optional pipeline statistics) per pass, from a frame
+        // GpuProfiler::kFrameLatency frames back. Filled in by GetStats().
+        GpuFrameStats GpuPasses{};
+        // Per-pass submission counters of the last completed frame. Filled in by GetStats().
+        FrameCounters Counters{};
 
         void Reset() {
             DrawCalls = 0;
             TriangleCount = 0;
+            ShadowPassMs = 0.0f;
+            ScenePassMs = 0.0f;
         }
     };
 
@@ -26,6 +47,8 @@ namespace se {
 
         static void BeginScene(const Camera &camera, const glm::mat4 &projection);
 
+        static void BeginScene(const glm::mat4 &view, const glm::mat4 &projection);
+
         static void EndScene();
 
         static void Submit(const std::shared_ptr<VertexArray> &vertexArray,
@@ -48,14 +71,26 @@ namespace se {
 
         static DirectionalLightData GetDirectionalLight();
 
+        // Write the next scene's input to path when it ends (see FrameCapture). Mesh data
+        // is read back on the thread that executes the scene's commands.
+        static void CaptureNextScene(const std::filesystem::path &path);
+
         static RenderStats GetStats() {
-            return stats_;
+            RenderStats stats = stats_;
+            stats.GpuPasses = GpuProfiler::GetResults();
+            stats.Counters = RenderCounters::GetLastFrame();
+            return stats;
         }
 
         static void ResetStats() {
             stats_.Reset();
         }
 
+        static void SetFrameLatency(float inputToSubmitMs, float fenceWaitMs) {
+            stats_.InputToSubmitMs = inputToSubmitMs;
+            stats_.FenceWaitMs = fenceWaitMs;
+        }
+
     private:
         struct Submission {
             std::shared_ptr<VertexArray> vertex_array;
@@ -79,7 +114,12 @@ namespace se {
             float ShadowOrthoSize = 10.0f;
             float AmbientStrength = 0.2f;
             bool ShadowsEnabled = true;
-            std::vector<Submission> Submissions;
+            bool ShadowResourcesQueued = false;
+            // Frame arena memory: filled between BeginScene and EndScene, released after
+            FrameVector<Submission> Submissions;
+            size_t LastSubmissionCount = 0;
+            // Set by CaptureNextScene, cleared once the scene is captured
+            std::filesystem::path CapturePath;
         };
 
         static SceneData *sceneData_;
@@ -92,5 +132,7 @@ namespace se {
         static void RenderShadowPass();
 
         static void RenderScenePass();
+
+        static void CaptureScene();
     };
 } // namespace se
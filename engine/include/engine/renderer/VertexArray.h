@@ -23,6 +23,9 @@ class VertexArray {
     const std::shared_ptr<IndexBuffer>& GetIndexBuffer() const {
         return indexBuffer_;
     }
+    uint32_t GetRendererID() const {
+        return rendererId_;
+    }
 
   private:
     uint32_t rendererId_;
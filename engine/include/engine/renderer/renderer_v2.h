@@ -12,11 +12,14 @@ struct Texture {
 struct Framebuffer {
     GLuint Handle = 0;
     Texture ColorAttachment;
+    GLuint DepthAttachment = 0; // Renderbuffer
 };
 
 Texture CreateTexture(int width, int height);
 Texture LoadTexture(const std::filesystem::path& path);
 Framebuffer CreateFramebufferWithTexture(const Texture texture);
 bool AttachTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture);
+bool AttachDepthBufferToFramebuffer(Framebuffer& framebuffer, uint32_t width, uint32_t height);
+void DestroyFramebuffer(Framebuffer& framebuffer);
 void BlitFramebufferToSwapchain(const Framebuffer framebuffer);
 } // namespace Renderer
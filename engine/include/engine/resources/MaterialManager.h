@@ -1,19 +1,28 @@
 #pragma once
 
+#include "engine/MainThreadQueue.h"
 #include "engine/Shader.h"
 #include "engine/renderer/Material.h"
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace se {
 
+struct ShaderSourceFiles {
+    std::string Name;
+    std::filesystem::path VertexPath;
+    std::filesystem::path FragmentPath;
+};
+
 class MaterialManager {
   public:
     static void Init();
     static void Shutdown();
 
-    // Get default material with basic shader
+    // Get default material with basic shader (compiled on first use)
     static std::shared_ptr<Material> GetDefaultMaterial();
 
     // Create a material with custom shader
@@ -24,6 +33,17 @@ class MaterialManager {
                                              const std::filesystem::path& vertPath,
                                              const std::filesystem::path& fragPath);
 
+    // Like GetShader, but compiling on a cache miss is deferred to the main-thread queue.
+    // onReady runs on the main thread (right away if cached).
+    static void GetShaderAsync(const std::string& name, const std::filesystem::path& vertPath,
+                               const std::filesystem::path& fragPath,
+                               std::function<void(std::shared_ptr<Shader>)> onReady,
+                               TaskPriority priority = TaskPriority::Normal);
+
+    // Load several shaders at once: files are read in parallel on the job system, then
+    // compiled on the calling (context) thread and cached under their names
+    static void PreloadShaders(const std::vector<ShaderSourceFiles>& shaders);
+
     // Clear all cached resources
     static void ClearCache();
 
@@ -31,6 +51,7 @@ class MaterialManager {
     MaterialManager() = delete;
 
     static void CreateDefaultShader();
+    static bool EnsureDefaultMaterial();
 
     static std::shared_ptr<Material> defaultMaterial_;
     static std::shared_ptr<Shader> defaultShader_;
@@ -1,10 +1,13 @@
 #pragma once
 
+#include "engine/MainThreadQueue.h"
 #include "engine/Mesh.h"
 #include "engine/renderer/VertexArray.h"
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace se {
 enum class PrimitiveMeshType { Triangle, Quad, Cube, Sphere, Capsule, Cylinder };
@@ -23,11 +26,23 @@ class MeshManager {
     // Get or create primitive mesh (cached)
     static std::shared_ptr<VertexArray> GetPrimitive(PrimitiveMeshType type);
 
+    // Like GetPrimitive, but a cache miss is created on the main-thread queue instead of
+    // stalling the caller's frame. onReady runs on the main thread (right away if cached).
+    static void GetPrimitiveAsync(PrimitiveMeshType type,
+                                  std::function<void(std::shared_ptr<VertexArray>)> onReady,
+                                  TaskPriority priority = TaskPriority::Normal);
+
+    // Build several primitives at once: mesh generation runs in parallel on the job system,
+    // the GL uploads then happen on the calling (context) thread
+    static void PreloadPrimitives(const std::vector<PrimitiveMeshType>& types);
+
     // Clear all cached meshes
     static void ClearCache();
 
   private:
     static std::shared_ptr<VertexArray> CreatePrimitive(PrimitiveMeshType type);
+    // CPU-only part of CreatePrimitive, safe on worker threads
+    static Mesh GeneratePrimitiveMesh(PrimitiveMeshType type);
 
     static std::unordered_map<PrimitiveMeshType, std::shared_ptr<VertexArray>> primitiveCache_;
     static bool initialized_;
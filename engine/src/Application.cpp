@@ -1,58 +1,187 @@
 
 #include "engine/Application.h"
+#include "engine/HardwareCounters.h"
 #include "engine/Input.h"
 #include "engine/Log.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
+#include "engine/renderer/GpuProfiler.h"
+#include "engine/renderer/RenderCounters.h"
+#include "engine/renderer/SceneRenderer.h"
 #include <GLFW/glfw3.h>
+#include <cmath>
 #include <glm.hpp>
 #include <imgui.h>
+#include <limits>
 
 namespace se {
 
 Application* Application::s_Instance = nullptr;
 
+// Frames rendered after input in OnDemand mode. ImGui needs a couple of frames to settle
+// (hover -> press -> release highlight) before the screen is stable again.
+static constexpr uint32_t kInputRedrawFrames = 3;
+
 Application::Application(const ApplicationSpec& specification) {
     if (s_Instance) {
         SE_LOG_ERROR("Application already exists!");
         return;
     }
     s_Instance = this;
+    startupTimer_.Start();
+    Profiler::SetThreadName("Main");
+    profileTracePath_ = specification.ProfileTracePath;
+    if (specification.HardwareCounters) {
+        HardwareCounters::Enable();
+    }
 
     SE_LOG_INFO("Starting Simple Engine");
 
+    {
+        StartupTimer::Scope timing(startupTimer_, "Job system");
+        JobSystemSpec jobSpec;
+        jobSpec.WorkerCount = specification.WorkerThreads;
+        jobSpec.PinWorkers = specification.PinWorkerThreads;
+        jobSystem_ = std::make_unique<JobSystem>(jobSpec);
+    }
+
+    if (specification.FlightRecorder) {
+        FlightRecorderSpec recorderSpec;
+        recorderSpec.HitchFactor = specification.HitchFactor;
+        recorderSpec.HitchMinMs = specification.HitchMinMs;
+        recorderSpec.OutputDirectory = specification.HitchDumpDirectory;
+        flightRecorder_ = std::make_unique<FlightRecorder>(recorderSpec, jobSystem_.get());
+    }
+
+    if (!specification.MetricsOutput.empty()) {
+        MetricsExporterSpec metricsSpec;
+        metricsSpec.Output = specification.MetricsOutput;
+        metricsSpec.Format = specification.MetricsOutputFormat;
+        metricsSpec.Interval = specification.MetricsInterval;
+        metricsExporter_ = std::make_unique<MetricsExporter>(metricsSpec);
+    }
+
+    captureFramePath_ = specification.CaptureFramePath;
+    captureFrame_ = specification.CaptureFrame;
+
+    // Two blocks: the render thread may still read what the previous frame allocated
+    frameArena_ = std::make_unique<FrameArena>(specification.FrameArenaSize, 2);
+
     // Create window
-    window_ = std::make_unique<Window>(specification);
+    {
+        StartupTimer::Scope timing(startupTimer_, "Window + GL context");
+        window_ = std::make_unique<Window>(specification);
+    }
+
+    renderMode_ = specification.Mode;
+
+    if (!specification.InputReplayPath.empty()) {
+        inputRecorder_.BeginPlayback(specification.InputReplayPath);
+        // Every recorded frame has to be simulated, idle or not
+        if (renderMode_ == RenderMode::OnDemand) {
+            SE_LOG_WARN("Input replay forces continuous rendering");
+            renderMode_ = RenderMode::Continuous;
+        }
+    } else if (!specification.InputRecordPath.empty()) {
+        inputRecorder_.BeginRecording(specification.InputRecordPath);
+    }
+    idleWaitTimeout_ = std::max(specification.IdleWaitTimeout, 0.001f);
+    if (renderMode_ == RenderMode::OnDemand) {
+        SE_LOG_INFO("On-demand rendering enabled (idle wait {} s)", idleWaitTimeout_);
+        RequestRedraw(kInputRedrawFrames);
+    }
+
+    mainThreadQueue_.SetBudget(specification.MainThreadBudgetMs);
+
+    justInTimeInput_ = specification.JustInTimeInput;
+    if (specification.MaxFramesInFlight > 0) {
+        SE_LOG_INFO("Low-latency mode: max {} frame(s) in flight{}",
+                    specification.MaxFramesInFlight,
+                    justInTimeInput_ ? ", just-in-time input" : "");
+    }
+
+    // VSync already paces presentation; the limiter only runs when it is off
+    if (!window_->IsVSync() && specification.TargetFrameRate > 0.0f) {
+        frameLimiter_.SetTargetFrameRate(specification.TargetFrameRate);
+        frameLimiter_.SetPacing(specification.FramePacing);
+        SE_LOG_INFO("Frame rate capped at {} FPS (pacing {})", specification.TargetFrameRate,
+                    specification.FramePacing ? "on" : "off");
+    }
+
+    if (specification.FixedUpdateRate > 0.0f) {
+        fixedTimestep_ = 1.0f / specification.FixedUpdateRate;
+        maxFixedStepsPerFrame_ = std::max(1u, specification.MaxFixedStepsPerFrame);
+    }
 
     // Create and initialize renderer
-    renderer_ = std::make_unique<Renderer>();
-    renderer_->Init();
+    {
+        StartupTimer::Scope timing(startupTimer_, "Renderer");
+        renderer_ = std::make_unique<Renderer>();
+        renderer_->Init();
+    }
 
     // Set default clear color
     renderer_->SetClearColor(0.1f, 0.1f, 0.15f, 1.0f);
 
+    if (specification.RenderThread) {
+        renderThread_ = std::make_unique<RenderThread>(*window_);
+        SE_LOG_INFO("Threaded rendering enabled");
+    }
+
+    if (window_->IsHeadless()) {
+        // No swapchain to draw into and nobody to look at ImGui
+        headlessFrameCount_ = specification.HeadlessFrameCount;
+        CreateOffscreenTarget();
+        return;
+    }
+
     // Create and attach ImGui layer
+    StartupTimer::Scope timing(startupTimer_, "ImGui");
     imguiLayer_ = std::make_shared<ImGuiLayer>();
     imguiLayer_->SetWindow(window_->GetNativeWindow());
+    imguiLayer_->SetThreadedRendering(renderThread_ != nullptr);
     imguiLayer_->OnAttach();
 }
 
 Application::~Application() {
     SE_LOG_INFO("Shutting down Simple Engine");
 
+    // Take the context back before anything releases GL objects
+    if (renderThread_) {
+        renderThread_->Stop();
+        for (auto& buffer : commandBuffers_)
+            buffer.Reset();
+    }
+
+    // Flushes the recording file before the layers and the window go away
+    inputRecorder_.Stop();
+
     // Detach ImGui
     if (imguiLayer_) {
         imguiLayer_->OnDetach();
     }
 
+    // Pending tasks may point into layers
+    mainThreadQueue_.Clear();
+
     // Cleanup layers
     for (auto& layer : layer_stack_) {
         layer->OnDetach();
     }
     layer_stack_.clear();
 
+    if (offscreenTarget_.Handle) {
+        ::Renderer::DestroyFramebuffer(offscreenTarget_);
+    }
+
     // Cleanup systems
     renderer_.reset();
     window_.reset();
     glfwTerminate();
+    frameArena_.reset();
+    // Waits for a dump job still writing
+    flightRecorder_.reset();
+    jobSystem_.reset();
 
     s_Instance = nullptr;
 }
@@ -61,12 +190,28 @@ int Application::Run() {
     running_ = true;
     float lastTime = GetTime();
 
+    // When the input the current frame is built from was sampled
+    float inputSampleTime = lastTime;
+
+    // Frame time statistics, reported at the end of headless runs
+    uint32_t frameCount = 0;
+    double totalFrameTime = 0.0;
+    float minFrameTime = std::numeric_limits<float>::max();
+    float maxFrameTime = 0.0f;
+
     SE_LOG_INFO("Application main loop started");
 
+    // From here on the main thread only holds the context during sync points
+    if (renderThread_) {
+        renderThread_->Start();
+    }
+
     while (running_) {
-        // Check for window close
-        if (Input::IsKeyPressed(GLFW_KEY_ESCAPE)) {
-            window_->RequestClose();
+        SE_PROFILE_SCOPE("Frame");
+
+        if (headlessFrameCount_ > 0 && frameCount >= headlessFrameCount_) {
+            Stop();
+            break;
         }
 
         if (window_->ShouldClose()) {
@@ -74,57 +219,417 @@ int Application::Run() {
             break;
         }
 
+        if (renderMode_ == RenderMode::OnDemand) {
+            SE_PROFILE_SCOPE("WaitEvents");
+            // Pending redraws only poll; otherwise sleep until something happens
+            if (pendingRedraws_.load() > 0) {
+                window_->OnUpdate();
+            } else if (window_->WaitEvents(idleWaitTimeout_)) {
+                RequestRedraw(kInputRedrawFrames);
+            }
+
+            uint32_t pending = pendingRedraws_.load();
+            while (pending > 0 && !pendingRedraws_.compare_exchange_weak(pending, pending - 1)) {
+            }
+
+            if (pending == 0) {
+                // Idle: don't let the skipped time show up as a huge timestep later
+                lastTime = GetTime();
+                inputSampleTime = lastTime;
+                continue;
+            }
+            inputSampleTime = GetTime();
+        }
+
         // Calculate timestep
         float currentTime = GetTime();
-        float timestep = glm::clamp(currentTime - lastTime, 0.001f, 0.1f);
+        float frameTime = currentTime - lastTime;
+        float timestep = glm::clamp(frameTime, 0.001f, 0.1f);
         lastTime = currentTime;
 
+        frameRecord_ = FrameRecord{};
+        frameRecord_.Index = frameCount;
+        frameRecord_.StartNs = Profiler::Now();
+        if (!captureFramePath_.empty() && frameCount == captureFrame_) {
+            SceneRenderer::CaptureNextScene(captureFramePath_);
+        }
+
+        // Replay swaps in the recorded input and timestep; frame times are still measured
+        EventQueue& events = window_->GetEvents();
+        if (inputRecorder_.IsReplaying()) {
+            events.DiscardInput();
+            if (!inputRecorder_.PlaybackFrame(timestep, events)) {
+                SE_LOG_INFO("Input replay finished after {} frame(s)",
+                            inputRecorder_.GetFrameIndex());
+                Stop();
+                break;
+            }
+        }
+
+        {
+            SE_PROFILE_SCOPE("Input");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Input));
+            // Everything below sees the same input for the whole frame
+            Input::ApplyEvents(events);
+            Input::BeginFrame();
+
+            if (inputRecorder_.IsRecording()) {
+                inputRecorder_.CaptureFrame(timestep);
+            }
+        }
+
+        // Closes at the top of the next iteration
+        if (Input::IsKeyPressed(GLFW_KEY_ESCAPE)) {
+            window_->RequestClose();
+        }
+
+        if (frameCount > 0) {
+            totalFrameTime += frameTime;
+            minFrameTime = std::min(minFrameTime, frameTime);
+            maxFrameTime = std::max(maxFrameTime, frameTime);
+        }
+        frameCount++;
+
+        // Transient allocations from two frames ago are no longer referenced
+        frameArena_->BeginFrame();
+
+        // With a render thread, every RenderCommand from here to the end of ImGui is
+        // recorded rather than issued
+        if (renderThread_) {
+            RenderCommand::SetRecordTarget(&commandBuffers_[recordIndex_]);
+        }
+
         // Begin frame
-        renderer_->BeginFrame();
+        {
+            SE_PROFILE_SCOPE("Renderer::BeginFrame");
+            renderer_->BeginFrame();
+        }
+
+        if (offscreenTarget_.Handle) {
+            RenderCommand::BindFramebuffer(offscreenTarget_.Handle);
+        }
 
-        int width, height;
-        glfwGetFramebufferSize(window_->GetNativeWindow(), &width, &height);
+        // Resizes and input that arrived since the last frame, in one batch per layer
+        {
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Input));
+            DispatchEvents();
+        }
 
         // Clear screen with the configured color
         renderer_->Clear();
 
-        if (window_->GetWidth() != width || window_->GetHeight() != height) {
-            window_->SetWidth(width);
-            window_->SetHeight(height);
+        // Fixed-rate simulation steps
+        if (fixedTimestep_ > 0.0f) {
+            SE_PROFILE_SCOPE("FixedUpdate");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::FixedUpdate));
+            fixedAccumulator_ += timestep;
+
+            uint32_t steps = 0;
+            while (fixedAccumulator_ >= fixedTimestep_ && steps < maxFixedStepsPerFrame_) {
+                for (uint32_t i = 0; i < layer_stack_.size(); ++i) {
+                    Layer& layer = *layer_stack_[i];
+                    SE_PROFILE_SCOPE(layer.GetProfileName());
+                    FrameTimer timer(frameRecord_.Layer(i, layer.GetProfileName()).UpdateMs);
+                    layer.OnFixedUpdate(fixedTimestep_);
+                }
+                fixedAccumulator_ -= fixedTimestep_;
+                steps++;
+            }
+
+            // Too far behind: drop whole steps instead of catching up in later frames
+            if (fixedAccumulator_ >= fixedTimestep_) {
+                fixedAccumulator_ = std::fmod(fixedAccumulator_, fixedTimestep_);
+            }
+
+            interpolationAlpha_ = fixedAccumulator_ / fixedTimestep_;
         }
 
         // Update all layers
-        for (const std::unique_ptr<Layer>& layer : layer_stack_) {
-            layer->OnUpdate(timestep);
+        {
+            SE_PROFILE_SCOPE("Update");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Update));
+            for (uint32_t i = 0; i < layer_stack_.size(); ++i) {
+                Layer& layer = *layer_stack_[i];
+                SE_PROFILE_SCOPE(layer.GetProfileName());
+                FrameTimer timer(frameRecord_.Layer(i, layer.GetProfileName()).UpdateMs);
+                layer.OnUpdate(timestep);
+            }
+        }
+
+        // Sample input once more so mouse-look reflects what arrived during the update
+        if (justInTimeInput_) {
+            window_->OnUpdate();
+            inputSampleTime = GetTime();
+            // The snapshot stays as it is for this frame; layers get the new events now
+            Input::ApplyEvents(window_->GetEvents());
+            DispatchEvents();
         }
 
         // Render all layers
-        for (const std::unique_ptr<Layer>& layer : layer_stack_) {
-            layer->OnRender();
+        {
+            SE_PROFILE_SCOPE("Render");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Render));
+            for (uint32_t i = 0; i < layer_stack_.size(); ++i) {
+                Layer& layer = *layer_stack_[i];
+                SE_PROFILE_SCOPE(layer.GetProfileName());
+                FrameTimer timer(frameRecord_.Layer(i, layer.GetProfileName()).RenderMs);
+                layer.OnRender();
+            }
+        }
+
+        // Queued GL-thread work (uploads, spawning) gets a fixed slice of the frame. With a
+        // render thread it runs at the sync point in SubmitRecordedFrame instead.
+        if (!renderThread_) {
+            SE_PROFILE_SCOPE("MainThreadQueue");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::MainThreadQueue));
+            mainThreadQueue_.Drain();
+            if (mainThreadQueue_.GetStats().Backlog > 0) {
+                RequestRedraw();
+            }
         }
 
         // End frame
         renderer_->EndFrame();
 
         // ImGui rendering
-        imguiLayer_->Begin();
+        if (imguiLayer_) {
+            SE_PROFILE_SCOPE("ImGui");
+            SE_ALLOC_TAG(UI);
+            FrameTimer phase(frameRecord_.Phase(FramePhase::ImGui));
+            imguiLayer_->Begin();
+
+            // Let layers draw their ImGui
+            for (uint32_t i = 0; i < layer_stack_.size(); ++i) {
+                Layer& layer = *layer_stack_[i];
+                SE_PROFILE_SCOPE(layer.GetProfileName());
+                FrameTimer timer(frameRecord_.Layer(i, layer.GetProfileName()).ImGuiMs);
+                layer.OnImGuiRender();
+            }
+
+            // Engine overlays (performance panel) on top
+            imguiLayer_->OnImGuiRender();
+
+            imguiLayer_->End();
+        }
+
+        // Swap buffers (or hand the frame to the render thread), wait out the frame cap and
+        // poll events
+        float submitTime = GetTime();
+        {
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Submit));
+            if (renderThread_) {
+                SE_PROFILE_SCOPE("SubmitRecordedFrame");
+                SubmitRecordedFrame();
+            } else {
+                SE_PROFILE_SCOPE("SwapBuffers");
+                window_->SwapBuffers();
+            }
+        }
+        SceneRenderer::SetFrameLatency((submitTime - inputSampleTime) * 1000.0f,
+                                       window_->GetLastFenceWaitMs());
+
+        if (!startupTimer_.IsFinished()) {
+            startupTimer_.AddPhase("First frame", (GetTime() - currentTime) * 1000.0f);
+            startupTimer_.Finish();
+        }
 
-        // Let layers draw their ImGui
-        for (const std::unique_ptr<Layer>& layer : layer_stack_) {
-            layer->OnImGuiRender();
+        {
+            SE_PROFILE_SCOPE("FrameLimiter::Wait");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Wait));
+            frameLimiter_.Wait();
         }
 
-        imguiLayer_->End();
+        // OnDemand polls (or waits) at the top of the next iteration instead
+        if (renderMode_ == RenderMode::Continuous) {
+            SE_PROFILE_SCOPE("PollEvents");
+            FrameTimer phase(frameRecord_.Phase(FramePhase::Wait));
+            window_->OnUpdate();
+            inputSampleTime = GetTime();
+        }
 
-        // Swap buffers and poll events
-        window_->SwapBuffers();
-        window_->OnUpdate();
+        frameRecord_.EndNs = Profiler::Now();
+        frameRecord_.FrameMs =
+            static_cast<float>((frameRecord_.EndNs - frameRecord_.StartNs) / 1.0e6);
+        RenderCounters::EndFrame();
+        AllocationTracker::EndFrame();
+        HardwareCounters::EndFrame();
+        frameRecord_.Hardware = HardwareCounters::GetLastFrame();
+        frameRecord_.Allocations = AllocationTracker::GetLastFrame();
+        frameRecord_.Render = SceneRenderer::GetStats();
+        if (imguiLayer_) {
+            imguiLayer_->GetPerformancePanel().AddFrame(frameRecord_);
+        }
+        if (flightRecorder_) {
+            flightRecorder_->AddFrame(frameRecord_);
+        }
+        if (metricsExporter_) {
+            metricsExporter_->AddFrame(frameRecord_);
+        }
+        lastFrameRecord_ = frameRecord_;
     }
 
     SE_LOG_INFO("Application main loop ended");
+
+    inputRecorder_.Stop();
+
+    if (renderThread_) {
+        renderThread_->Stop();
+        for (auto& buffer : commandBuffers_)
+            buffer.Reset();
+    }
+
+    if (window_->IsHeadless() && frameCount > 1) {
+        // The first frame has no previous timestamp, so it isn't part of the statistics
+        double avgMs = totalFrameTime * 1000.0 / (frameCount - 1);
+        SE_LOG_INFO("Headless run: {} frames, avg {:.3f} ms, min {:.3f} ms, max {:.3f} ms",
+                    frameCount, avgMs, minFrameTime * 1000.0f, maxFrameTime * 1000.0f);
+
+        GpuFrameStats gpu = GpuProfiler::GetResults();
+        SE_LOG_INFO("Headless run GPU: shadow {:.3f} ms, scene {:.3f} ms ({} frame(s) dropped)",
+                    gpu[size_t(GpuPass::Shadow)].Milliseconds,
+                    gpu[size_t(GpuPass::Scene)].Milliseconds, GpuProfiler::GetDroppedFrameCount());
+        if (flightRecorder_) {
+            SE_LOG_INFO("Headless run hitches: {} (median busy {:.3f} ms)",
+                        flightRecorder_->GetHitchCount(), flightRecorder_->GetMedianBusyMs());
+        }
+        if (metricsExporter_) {
+            SE_LOG_INFO("Headless run metrics: {} line(s) exported, {} dropped",
+                        metricsExporter_->GetExportedCount(), metricsExporter_->GetDroppedCount());
+        }
+
+        const FrameCounters& counters = RenderCounters::GetLastFrame();
+        PassCounters total = counters.Total();
+        SE_LOG_INFO("Headless run last frame: {} draws ({} shadow), {} program binds, {} texture "
+                    "binds, {} uniform uploads ({} bytes), {} objects submitted, {} culled",
+                    total.DrawCalls, counters.Pass(GpuPass::Shadow).DrawCalls,
+                    total.ProgramBinds, total.TextureBinds, total.UniformUploads,
+                    total.UniformBytes, counters.ObjectsSubmitted, counters.ObjectsCulled);
+
+        if (HardwareCounters::IsEnabled()) {
+            const HardwareFrameStats& hardware = HardwareCounters::GetLastFrame();
+            auto logCounters = [](const char* label, const CounterValues& values) {
+                SE_LOG_INFO("  {}: {} cycles, {} instructions (IPC {:.2f}), {} L1D / {} LLC "
+                            "misses, {} branch misses, {} page faults",
+                            label, values.Get(HardwareCounter::Cycles),
+                            values.Get(HardwareCounter::Instructions),
+                            values.InstructionsPerCycle(),
+                            values.Get(HardwareCounter::L1DMisses),
+                            values.Get(HardwareCounter::LLCMisses),
+                            values.Get(HardwareCounter::BranchMisses),
+                            values.Get(HardwareCounter::PageFaults));
+            };
+            SE_LOG_INFO("Headless run hardware counters, last frame:");
+            logCounters("Main thread", hardware.MainThread);
+            logCounters("Workers", hardware.Workers);
+            for (uint32_t i = 0; i < hardware.ScopeCount; ++i)
+                logCounters(hardware.Scopes[i].Name, hardware.Scopes[i].Values);
+        }
+
+        if (AllocationTracker::IsCompiledIn()) {
+            AllocationFrameStats allocations = AllocationTracker::GetLastFrame();
+            AllocationCounters frameTotal = allocations.Total();
+            SE_LOG_INFO("Headless run allocations, last frame: {} ({} bytes), {} in zero-alloc "
+                        "scopes",
+                        frameTotal.Count, frameTotal.Bytes, allocations.ZeroAllocViolations);
+            for (size_t i = 0; i < kAllocTagCount; ++i) {
+                const AllocationCounters& tag = allocations.Tags[i];
+                if (tag.Count > 0)
+                    SE_LOG_INFO("  {}: {} ({} bytes)",
+                                AllocationTracker::GetTagName(static_cast<AllocTag>(i)),
+                                tag.Count, tag.Bytes);
+            }
+        }
+    }
+
+    if (!profileTracePath_.empty()) {
+        Profiler::WriteChromeTrace(profileTracePath_);
+    }
+
     return 0;
 }
 
+void Application::DispatchEvents() {
+    EventQueue& events = window_->GetEvents();
+    if (events.IsEmpty())
+        return;
+
+    SE_PROFILE_FUNCTION();
+
+    if (events.GetDroppedCount() > 0) {
+        SE_LOG_WARN("Event queue full: dropped {} event(s)", events.GetDroppedCount());
+    }
+
+    events.ForEach([this](Event& event) {
+        if (event.Type != EventType::WindowResize)
+            return;
+        window_->SetWidth(event.Resize.Width);
+        window_->SetHeight(event.Resize.Height);
+        if (!offscreenTarget_.Handle) {
+            RenderCommand::SetViewport(0, 0, event.Resize.Width, event.Resize.Height);
+        }
+    });
+
+    // ImGui sits on top of every layer
+    if (imguiLayer_) {
+        imguiLayer_->OnEvents(events);
+    }
+    for (auto it = layer_stack_.rbegin(); it != layer_stack_.rend(); ++it) {
+        (*it)->OnEvents(events);
+    }
+
+    events.Clear();
+}
+
+void Application::SubmitRecordedFrame() {
+    RenderCommand::SetRecordTarget(nullptr);
+
+    // Sync point: the previous frame has executed and the context is free
+    renderThread_->WaitIdle();
+    window_->MakeContextCurrent();
+
+    mainThreadQueue_.Drain();
+    if (mainThreadQueue_.GetStats().Backlog > 0) {
+        RequestRedraw();
+    }
+
+    // The previous frame's buffer holds the last references to resources dropped since;
+    // release them while the context is current here
+    uint32_t previousIndex = (recordIndex_ + 1) % commandBuffers_.size();
+    commandBuffers_[previousIndex].Reset();
+
+    window_->ReleaseContext();
+
+    renderThread_->Submit(commandBuffers_[recordIndex_]);
+    recordIndex_ = previousIndex;
+}
+
+void Application::CreateOffscreenTarget() {
+    uint32_t width = window_->GetWidth();
+    uint32_t height = window_->GetHeight();
+
+    ::Renderer::Texture color = ::Renderer::CreateTexture((int)width, (int)height);
+    offscreenTarget_ = ::Renderer::CreateFramebufferWithTexture(color);
+    if (!offscreenTarget_.Handle ||
+        !::Renderer::AttachDepthBufferToFramebuffer(offscreenTarget_, width, height)) {
+        throw std::runtime_error("Failed to create headless offscreen framebuffer");
+    }
+
+    RenderCommand::BindFramebuffer(offscreenTarget_.Handle);
+    RenderCommand::SetViewport(0, 0, width, height);
+
+    SE_LOG_INFO("Headless offscreen target created ({}x{})", width, height);
+}
+
+void Application::RequestRedraw(uint32_t frames) {
+    uint32_t pending = pendingRedraws_.load();
+    while (pending < frames && !pendingRedraws_.compare_exchange_weak(pending, frames)) {
+    }
+
+    // Wake the main thread if it is blocked waiting for events
+    if (renderMode_ == RenderMode::OnDemand && running_.load(std::memory_order_relaxed))
+        window_->PostWakeup();
+}
+
 void Application::Stop() {
     running_ = false;
 }
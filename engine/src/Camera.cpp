@@ -1,6 +1,7 @@
 #include "ext/matrix_clip_space.hpp"
 #include "ext/matrix_transform.hpp"
 #include <engine/Camera.h>
+#include <engine/Log.h>
 
 Camera::Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
     : position_(position), world_up_(up), yaw_(yaw), pitch_(pitch),
@@ -0,0 +1,61 @@
+#include "engine/EventQueue.h"
+
+namespace se {
+
+void EventQueue::Push(const Event& event) {
+    if (event.Type == EventType::WindowResize && resizeSlot_ != kNoResize) {
+        // Only the final size matters; keep the earlier slot so nothing shifts
+        events_[(head_ + resizeSlot_) % kCapacity].Resize = event.Resize;
+        return;
+    }
+
+    if (count_ > 0) {
+        Event& last = Back();
+        if (!last.Handled && last.Type == event.Type) {
+            if (event.Type == EventType::MouseMoved) {
+                last.Mouse = event.Mouse;
+                return;
+            }
+            if (event.Type == EventType::MouseScrolled) {
+                last.Mouse.X += event.Mouse.X;
+                last.Mouse.Y += event.Mouse.Y;
+                return;
+            }
+        }
+    }
+
+    if (count_ == kCapacity) {
+        dropped_++;
+        return;
+    }
+
+    if (event.Type == EventType::WindowResize)
+        resizeSlot_ = count_;
+
+    events_[(head_ + count_) % kCapacity] = event;
+    count_++;
+}
+
+void EventQueue::DiscardInput() {
+    uint32_t kept = 0;
+    resizeSlot_ = kNoResize;
+    for (uint32_t i = 0; i < count_; ++i) {
+        const Event& event = events_[(head_ + i) % kCapacity];
+        if (event.IsKeyboard() || event.IsMouse())
+            continue;
+        if (event.Type == EventType::WindowResize)
+            resizeSlot_ = kept;
+        events_[(head_ + kept) % kCapacity] = event;
+        kept++;
+    }
+    count_ = kept;
+}
+
+void EventQueue::Clear() {
+    head_ = (head_ + count_) % kCapacity;
+    count_ = 0;
+    dropped_ = 0;
+    resizeSlot_ = kNoResize;
+}
+
+} // namespace se
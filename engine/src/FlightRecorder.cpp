@@ -0,0 +1,194 @@
+#include "engine/FlightRecorder.h"
+#include "engine/Log.h"
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <spdlog/fmt/fmt.h>
+
+namespace se {
+
+namespace {
+
+// The synthetic track the frames are drawn on; profiler thread ids start at 1
+constexpr uint32_t kFramesTrackId = 0;
+
+struct DumpData {
+    std::string Path;
+    std::string Reason;
+    uint64_t HitchFrame = 0;
+    float MedianBusyMs = 0.0f;
+    std::vector<FrameRecord> Frames; // Oldest first
+    std::vector<ProfileThreadCapture> Threads;
+    std::vector<std::string> LogLines;
+};
+
+void AppendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20)
+            out += c;
+    }
+    out += '"';
+}
+
+void AppendFrameEvent(std::string& out, const FrameRecord& frame, bool hitch) {
+    auto inserter = std::back_inserter(out);
+    fmt::format_to(inserter,
+                   "{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},"
+                   "\"dur\":{:.3f},\"args\":{{\"frame\":{},\"frameMs\":{:.3f}",
+                   hitch ? "Frame (hitch)" : "Frame", kFramesTrackId, frame.StartNs / 1000.0,
+                   (frame.EndNs - frame.StartNs) / 1000.0, frame.Index, frame.FrameMs);
+    for (size_t i = 0; i < kFramePhaseCount; ++i) {
+        out += ',';
+        AppendJsonString(out, GetFramePhaseName(static_cast<FramePhase>(i)));
+        fmt::format_to(inserter, ":{:.3f}", frame.PhaseMs[i]);
+    }
+    for (uint32_t i = 0; i < frame.LayerCount; ++i) {
+        const LayerTiming& layer = frame.Layers[i];
+        out += ',';
+        AppendJsonString(out, fmt::format("Layer {}", layer.Name ? layer.Name : "?"));
+        fmt::format_to(inserter, ":\"update {:.3f} / render {:.3f} / imgui {:.3f}\"",
+                       layer.UpdateMs, layer.RenderMs, layer.ImGuiMs);
+    }
+
+    const RenderStats& render = frame.Render;
+    PassCounters counters = render.Counters.Total();
+    AllocationCounters allocations = frame.Allocations.Total();
+    fmt::format_to(inserter,
+                   ",\"drawCalls\":{},\"triangles\":{},\"shadowPassMs\":{:.3f},"
+                   "\"scenePassMs\":{:.3f},\"gpuShadowMs\":{:.3f},\"gpuSceneMs\":{:.3f},"
+                   "\"programBinds\":{},\"textureBinds\":{},\"uniformUploads\":{},"
+                   "\"bufferUploadBytes\":{},\"objectsSubmitted\":{},\"allocations\":{},"
+                   "\"allocatedBytes\":{}}}}}",
+                   render.DrawCalls, render.TriangleCount, render.ShadowPassMs,
+                   render.ScenePassMs, render.GpuPasses[size_t(GpuPass::Shadow)].Milliseconds,
+                   render.GpuPasses[size_t(GpuPass::Scene)].Milliseconds,
+                   counters.ProgramBinds, counters.TextureBinds, counters.UniformUploads,
+                   counters.BufferBytes, render.Counters.ObjectsSubmitted, allocations.Count,
+                   allocations.Bytes);
+}
+
+void WriteDump(const DumpData& dump) {
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(dump.Path).parent_path(), error);
+
+    std::string events = fmt::format("{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                                     "\"tid\":{},\"args\":{{\"name\":\"Frames\"}}}}",
+                                     kFramesTrackId);
+    for (const FrameRecord& frame : dump.Frames) {
+        events += ",\n";
+        AppendFrameEvent(events, frame, frame.Index == dump.HitchFrame);
+    }
+
+    std::string fields = "\"flightRecorder\":{\"reason\":";
+    AppendJsonString(fields, dump.Reason);
+    fmt::format_to(std::back_inserter(fields),
+                   ",\"frame\":{},\"medianBusyMs\":{:.3f},\"logLines\":[", dump.HitchFrame,
+                   dump.MedianBusyMs);
+    for (size_t i = 0; i < dump.LogLines.size(); ++i) {
+        std::string_view line = dump.LogLines[i];
+        while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+            line.remove_suffix(1);
+        fields += i > 0 ? ",\n" : "\n";
+        AppendJsonString(fields, line);
+    }
+    fields += "]}";
+
+    if (Profiler::WriteChromeTrace(dump.Path, dump.Threads, events, fields))
+        SE_LOG_WARN("Flight recorder: {} frame(s) written to '{}'", dump.Frames.size(),
+                    dump.Path);
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(const FlightRecorderSpec& spec, JobSystem* jobSystem)
+    : spec_(spec), jobSystem_(jobSystem) {
+    spec_.FrameCount = std::max(spec_.FrameCount, 1u);
+    frames_.resize(spec_.FrameCount);
+    medianScratch_.reserve(spec_.FrameCount);
+}
+
+FlightRecorder::~FlightRecorder() {
+    // Dump jobs only hold their own copy of the data, but the counter lives here
+    if (jobSystem_)
+        jobSystem_->WaitForCounter(pendingDumps_);
+}
+
+void FlightRecorder::AddFrame(const FrameRecord& record) {
+    float busyMs = BusyMs(record);
+    bool hitch = count_ >= kWarmupFrames &&
+                 busyMs > std::max(medianBusyMs_ * spec_.HitchFactor, spec_.HitchMinMs);
+
+    frames_[head_] = record;
+    head_ = (head_ + 1) % spec_.FrameCount;
+    count_ = std::min(count_ + 1, spec_.FrameCount);
+    float medianBeforeHitch = medianBusyMs_;
+    UpdateMedian();
+
+    if (!hitch)
+        return;
+
+    hitchCount_++;
+    SE_LOG_WARN("Hitch: frame {} was busy for {:.2f} ms (median {:.2f} ms)", record.Index,
+                busyMs, medianBeforeHitch);
+
+    if (dumpCount_ >= spec_.MaxDumps) {
+        return;
+    }
+    // One dump at a time; a hitch right after another is already in its window
+    if (!pendingDumps_.IsDone()) {
+        return;
+    }
+    Dump("hitch");
+}
+
+void FlightRecorder::Dump(const char* reason) {
+    if (count_ == 0)
+        return;
+
+    const FrameRecord& newest = GetFrame(0);
+    const FrameRecord& oldest = GetFrame(count_ - 1);
+
+    auto dump = std::make_shared<DumpData>();
+    dump->Reason = reason;
+    dump->HitchFrame = newest.Index;
+    dump->MedianBusyMs = medianBusyMs_;
+    dump->Path = fmt::format("{}/{}_frame{}.json", spec_.OutputDirectory, reason, newest.Index);
+    dump->Frames.reserve(count_);
+    for (uint32_t age = count_; age-- > 0;)
+        dump->Frames.push_back(GetFrame(age));
+    dump->Threads = Profiler::Capture(oldest.StartNs, newest.EndNs);
+    dump->LogLines = GetRecentLogLines();
+
+    dumpCount_++;
+    lastDumpPath_ = dump->Path;
+
+    // Formatting and file I/O stay off the main thread, which already had a bad frame
+    if (jobSystem_) {
+        jobSystem_->Schedule([dump]() { WriteDump(*dump); }, &pendingDumps_);
+    } else {
+        WriteDump(*dump);
+    }
+}
+
+float FlightRecorder::BusyMs(const FrameRecord& record) {
+    return record.FrameMs - record.GetPhase(FramePhase::Wait);
+}
+
+const FrameRecord& FlightRecorder::GetFrame(uint32_t age) const {
+    return frames_[(head_ + spec_.FrameCount - 1 - age) % spec_.FrameCount];
+}
+
+void FlightRecorder::UpdateMedian() {
+    medianScratch_.clear();
+    for (uint32_t age = 0; age < count_; ++age)
+        medianScratch_.push_back(BusyMs(GetFrame(age)));
+
+    auto middle = medianScratch_.begin() + medianScratch_.size() / 2;
+    std::nth_element(medianScratch_.begin(), middle, medianScratch_.end());
+    medianBusyMs_ = *middle;
+}
+
+} // namespace se
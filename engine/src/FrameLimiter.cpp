@@ -0,0 +1,83 @@
+#include "engine/FrameLimiter.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#    include <cerrno>
+#    include <time.h>
+#endif
+
+namespace se {
+
+using namespace std::chrono_literals;
+
+void FrameLimiter::SetTargetFrameRate(float framesPerSecond) {
+    if (framesPerSecond <= 0.0f) {
+        targetFrameTime_ = Clock::duration{0};
+    } else {
+        targetFrameTime_ = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / framesPerSecond));
+    }
+    nextDeadline_ = Clock::time_point{};
+}
+
+void FrameLimiter::Wait() {
+    if (!IsEnabled())
+        return;
+
+    Clock::time_point now = Clock::now();
+
+    // First frame: nothing to wait for yet
+    if (nextDeadline_ == Clock::time_point{}) {
+        nextDeadline_ = now + targetFrameTime_;
+        return;
+    }
+
+    const Clock::time_point deadline = nextDeadline_;
+    if (now < deadline) {
+        // Sleep through most of the interval...
+        const Clock::time_point sleepTarget = deadline - spinWindow_;
+        if (now < sleepTarget) {
+            SleepUntil(sleepTarget);
+
+            // Track how late the sleep woke up and size the spin window from it
+            Clock::duration overshoot = std::max(Clock::now() - sleepTarget, Clock::duration{0});
+            sleepOvershoot_ = (sleepOvershoot_ * 7 + overshoot) / 8;
+            spinWindow_ = std::clamp<Clock::duration>(sleepOvershoot_ * 2, 100us, 4ms);
+        }
+
+        // ...and spin the rest for precision
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        now = Clock::now();
+    }
+
+    if (pacing_) {
+        nextDeadline_ = deadline + targetFrameTime_;
+        // More than a whole frame behind: re-anchor instead of rushing to catch up
+        if (now >= nextDeadline_) {
+            nextDeadline_ = now + targetFrameTime_;
+        }
+    } else {
+        nextDeadline_ = now + targetFrameTime_;
+    }
+}
+
+void FrameLimiter::SleepUntil(Clock::time_point deadline) {
+#ifdef __linux__
+    // steady_clock is CLOCK_MONOTONIC on Linux; an absolute deadline avoids drift from
+    // interrupted or late-starting relative sleeps
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        deadline.time_since_epoch());
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+} // namespace se
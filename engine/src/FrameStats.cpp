@@ -0,0 +1,75 @@
+#include "engine/FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <spdlog/fmt/fmt.h>
+
+namespace se {
+
+namespace {
+
+void AppendSummary(std::string& out, const char* name, const SampleSummary& summary) {
+    fmt::format_to(std::back_inserter(out),
+                   "  \"{}\": {{\"min\": {:.3f}, \"avg\": {:.3f}, \"p50\": {:.3f}, \"p99\": "
+                   "{:.3f}, \"max\": {:.3f}}},\n",
+                   name, summary.Min, summary.Avg, summary.P50, summary.P99, summary.Max);
+}
+
+} // namespace
+
+float Percentile(float* values, size_t count, float percentile) {
+    if (count == 0)
+        return 0.0f;
+    size_t index = static_cast<size_t>(std::ceil(percentile * count));
+    index = std::min(index > 0 ? index - 1 : 0, count - 1);
+    std::nth_element(values, values + index, values + count);
+    return values[index];
+}
+
+SampleSummary Summarize(std::vector<float> samples) {
+    SampleSummary summary;
+    if (samples.empty())
+        return summary;
+
+    summary.Min = *std::min_element(samples.begin(), samples.end());
+    summary.Max = *std::max_element(samples.begin(), samples.end());
+    summary.Avg = std::accumulate(samples.begin(), samples.end(), 0.0f) / samples.size();
+    summary.P50 = Percentile(samples.data(), samples.size(), 0.50f);
+    summary.P99 = Percentile(samples.data(), samples.size(), 0.99f);
+    return summary;
+}
+
+FrameSampler::FrameSampler(uint64_t warmupFrames, uint32_t frames)
+    : warmupFrames_(warmupFrames), frames_(frames) {
+    frameMs_.reserve(frames_);
+    busyMs_.reserve(frames_);
+    renderMs_.reserve(frames_);
+    gpuMs_.reserve(frames_);
+}
+
+bool FrameSampler::Add(const FrameRecord& record) {
+    if (IsDone() || record.EndNs == 0 || record.Index < warmupFrames_)
+        return false;
+
+    if (frameMs_.empty())
+        firstFrame_ = record.Index;
+    frameMs_.push_back(record.FrameMs);
+    busyMs_.push_back(record.FrameMs - record.GetPhase(FramePhase::Wait));
+    renderMs_.push_back(record.GetPhase(FramePhase::Render));
+    float gpuMs = 0.0f;
+    for (const GpuPassStats& pass : record.Render.GpuPasses)
+        gpuMs += pass.Milliseconds;
+    gpuMs_.push_back(gpuMs);
+    lastRecord_ = record;
+    return true;
+}
+
+void FrameSampler::AppendJson(std::string& out) const {
+    AppendSummary(out, "cpuFrameMs", Summarize(frameMs_));
+    AppendSummary(out, "cpuBusyMs", Summarize(busyMs_));
+    AppendSummary(out, "cpuRenderMs", Summarize(renderMs_));
+    AppendSummary(out, "gpuFrameMs", Summarize(gpuMs_));
+}
+
+} // namespace se
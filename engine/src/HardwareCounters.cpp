@@ -0,0 +1,333 @@
+#include "engine/HardwareCounters.h"
+#include "engine/Log.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace se {
+
+namespace {
+
+// One perf event group per attached thread. The fds stay readable from any thread, which
+// is how EndFrame collects the workers.
+struct CounterGroup {
+    int LeaderFd = -1;
+    std::array<int, kHardwareCounterCount> Fds;
+    // Position of each counter in the group read, -1 if it isn't open
+    std::array<int, kHardwareCounterCount> ReadIndex;
+    uint32_t OpenCount = 0;
+    bool Worker = false;
+
+    CounterGroup() {
+        Fds.fill(-1);
+        ReadIndex.fill(-1);
+    }
+};
+
+struct ScopeTotals {
+    const char* Name = nullptr;
+    std::atomic<uint32_t> Calls{0};
+    std::array<std::atomic<uint64_t>, kHardwareCounterCount> Values{};
+};
+
+std::atomic<bool> s_Enabled{false};
+std::array<bool, kHardwareCounterCount> s_Available{};
+
+std::mutex s_GroupsMutex;
+std::vector<CounterGroup*> s_Groups;
+// Counts of worker groups that closed, so the worker total doesn't drop when one exits
+CounterValues s_ExitedWorkers;
+
+std::array<ScopeTotals, HardwareFrameStats::kMaxScopes> s_Scopes;
+std::atomic<uint32_t> s_ScopeCount{0};
+
+// Main thread only (EndFrame)
+HardwareFrameStats s_LastFrame;
+CounterValues s_PreviousMain;
+CounterValues s_PreviousWorkers;
+std::array<CounterScopeStats, HardwareFrameStats::kMaxScopes> s_PreviousScopes{};
+
+#if defined(__linux__)
+
+struct CounterConfig {
+    uint32_t Type;
+    uint64_t Config;
+};
+
+constexpr uint64_t CacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+constexpr CounterConfig kConfigs[kHardwareCounterCount] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, CacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                     PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+int OpenCounter(const CounterConfig& config, int groupFd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = config.Type;
+    attr.config = config.Config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // pid 0 / cpu -1: the calling thread, on whichever CPU it runs
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC));
+}
+
+std::unique_ptr<CounterGroup> OpenGroup(bool worker, int* firstError) {
+    auto group = std::make_unique<CounterGroup>();
+    group->Worker = worker;
+    for (size_t i = 0; i < kHardwareCounterCount; ++i) {
+        int fd = OpenCounter(kConfigs[i], group->LeaderFd);
+        if (fd < 0) {
+            if (firstError && *firstError == 0)
+                *firstError = errno;
+            continue;
+        }
+        if (group->LeaderFd < 0)
+            group->LeaderFd = fd;
+        group->Fds[i] = fd;
+        group->ReadIndex[i] = static_cast<int>(group->OpenCount++);
+    }
+    if (group->OpenCount == 0)
+        return nullptr;
+    return group;
+}
+
+void CloseGroup(CounterGroup& group) {
+    for (int fd : group.Fds) {
+        if (fd >= 0)
+            close(fd);
+    }
+    group.Fds.fill(-1);
+    group.LeaderFd = -1;
+}
+
+bool ReadGroup(const CounterGroup& group, CounterValues& values) {
+    // nr, time enabled, time running, then one value per open counter
+    uint64_t buffer[3 + kHardwareCounterCount];
+    ssize_t bytes = read(group.LeaderFd, buffer, sizeof(buffer));
+    if (bytes < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+        return false;
+
+    uint64_t enabled = buffer[1];
+    uint64_t running = buffer[2];
+    // Scale up if the kernel had to multiplex the group with other perf users
+    double scale = running > 0 && running < enabled ? double(enabled) / running : 1.0;
+    for (size_t i = 0; i < kHardwareCounterCount; ++i) {
+        int index = group.ReadIndex[i];
+        values.Values[i] =
+            index >= 0 && index < int(buffer[0]) ? uint64_t(buffer[3 + index] * scale) : 0;
+    }
+    return true;
+}
+
+#else
+
+std::unique_ptr<CounterGroup> OpenGroup(bool, int*) {
+    return nullptr;
+}
+void CloseGroup(CounterGroup&) {}
+bool ReadGroup(const CounterGroup&, CounterValues&) {
+    return false;
+}
+
+#endif
+
+// Owns the calling thread's group; unregisters it when the thread exits
+struct ThreadCounters {
+    std::unique_ptr<CounterGroup> Group;
+    bool Attempted = false;
+
+    ~ThreadCounters() {
+        if (!Group)
+            return;
+        std::lock_guard<std::mutex> lock(s_GroupsMutex);
+        if (Group->Worker) {
+            CounterValues values;
+            if (ReadGroup(*Group, values))
+                s_ExitedWorkers += values;
+        }
+        std::erase(s_Groups, Group.get());
+        CloseGroup(*Group);
+    }
+};
+
+thread_local ThreadCounters t_Counters;
+
+void Register(std::unique_ptr<CounterGroup> group) {
+    std::lock_guard<std::mutex> lock(s_GroupsMutex);
+    s_Groups.push_back(group.get());
+    t_Counters.Group = std::move(group);
+}
+
+} // namespace
+
+HardwareCounters::ScopeSlot::ScopeSlot(const char* name) {
+    index_ = s_ScopeCount.fetch_add(1);
+    if (index_ < HardwareFrameStats::kMaxScopes) {
+        s_Scopes[index_].Name = name;
+    } else {
+        SE_LOG_WARN("Too many counter scopes, ignoring '{}'", name);
+        index_ = HardwareFrameStats::kMaxScopes;
+    }
+}
+
+HardwareCounters::Scope::Scope(const ScopeSlot& slot) : slot_(slot.index_) {
+    if (slot_ < HardwareFrameStats::kMaxScopes && s_Enabled.load(std::memory_order_relaxed))
+        active_ = ReadThread(start_);
+}
+
+HardwareCounters::Scope::~Scope() {
+    CounterValues end;
+    if (!active_ || !ReadThread(end))
+        return;
+
+    ScopeTotals& totals = s_Scopes[slot_];
+    CounterValues delta = end - start_;
+    totals.Calls.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < kHardwareCounterCount; ++i)
+        totals.Values[i].fetch_add(delta.Values[i], std::memory_order_relaxed);
+}
+
+bool HardwareCounters::Enable() {
+    if (s_Enabled.load())
+        return true;
+
+#if defined(__linux__)
+    int error = 0;
+    std::unique_ptr<CounterGroup> group = OpenGroup(false, &error);
+    if (!group) {
+        SE_LOG_WARN("Hardware counters unavailable: perf_event_open failed ({}); check "
+                    "/proc/sys/kernel/perf_event_paranoid",
+                    std::strerror(error));
+        return false;
+    }
+
+    for (size_t i = 0; i < kHardwareCounterCount; ++i) {
+        s_Available[i] = group->Fds[i] >= 0;
+        if (!s_Available[i])
+            SE_LOG_WARN("Hardware counter '{}' not supported here",
+                        GetCounterName(static_cast<HardwareCounter>(i)));
+    }
+    t_Counters.Attempted = true;
+    Register(std::move(group));
+    ReadThread(s_PreviousMain);
+    s_Enabled.store(true);
+    SE_LOG_INFO("Hardware counters enabled");
+    return true;
+#else
+    SE_LOG_WARN("Hardware counters need Linux perf_event_open");
+    return false;
+#endif
+}
+
+bool HardwareCounters::IsEnabled() {
+    return s_Enabled.load(std::memory_order_relaxed);
+}
+
+bool HardwareCounters::IsAvailable(HardwareCounter counter) {
+    return s_Available[static_cast<size_t>(counter)];
+}
+
+void HardwareCounters::AttachThread(bool worker) {
+    if (t_Counters.Attempted || !s_Enabled.load(std::memory_order_relaxed))
+        return;
+
+    // One attempt per thread; a failure here (fd limit) just leaves the thread uncounted
+    t_Counters.Attempted = true;
+    if (std::unique_ptr<CounterGroup> group = OpenGroup(worker, nullptr))
+        Register(std::move(group));
+}
+
+bool HardwareCounters::ReadThread(CounterValues& values) {
+    return t_Counters.Group && ReadGroup(*t_Counters.Group, values);
+}
+
+void HardwareCounters::EndFrame() {
+    if (!s_Enabled.load(std::memory_order_relaxed))
+        return;
+
+    HardwareFrameStats frame;
+
+    CounterValues main;
+    if (ReadThread(main)) {
+        frame.MainThread = main - s_PreviousMain;
+        s_PreviousMain = main;
+    }
+
+    CounterValues workers;
+    {
+        std::lock_guard<std::mutex> lock(s_GroupsMutex);
+        workers = s_ExitedWorkers;
+        for (const CounterGroup* group : s_Groups) {
+            CounterValues values;
+            if (group->Worker && ReadGroup(*group, values))
+                workers += values;
+        }
+    }
+    frame.Workers = workers - s_PreviousWorkers;
+    s_PreviousWorkers = workers;
+
+    uint32_t scopeCount = std::min(s_ScopeCount.load(), HardwareFrameStats::kMaxScopes);
+    for (uint32_t i = 0; i < scopeCount; ++i) {
+        CounterScopeStats totals;
+        totals.Name = s_Scopes[i].Name;
+        totals.Calls = s_Scopes[i].Calls.load(std::memory_order_relaxed);
+        for (size_t c = 0; c < kHardwareCounterCount; ++c)
+            totals.Values.Values[c] = s_Scopes[i].Values[c].load(std::memory_order_relaxed);
+
+        CounterScopeStats& scope = frame.Scopes[i];
+        scope.Name = totals.Name;
+        scope.Calls = totals.Calls - s_PreviousScopes[i].Calls;
+        scope.Values = totals.Values - s_PreviousScopes[i].Values;
+        s_PreviousScopes[i] = totals;
+    }
+    frame.ScopeCount = scopeCount;
+
+    s_LastFrame = frame;
+}
+
+const HardwareFrameStats& HardwareCounters::GetLastFrame() {
+    return s_LastFrame;
+}
+
+const char* HardwareCounters::GetCounterName(HardwareCounter counter) {
+    switch (counter) {
+    case HardwareCounter::Cycles:
+        return "Cycles";
+    case HardwareCounter::Instructions:
+        return "Instructions";
+    case HardwareCounter::L1DMisses:
+        return "L1D misses";
+    case HardwareCounter::LLCMisses:
+        return "LLC misses";
+    case HardwareCounter::BranchMisses:
+        return "Branch misses";
+    case HardwareCounter::PageFaults:
+        return "Page faults";
+    default:
+        return "Unknown";
+    }
+}
+
+} // namespace se
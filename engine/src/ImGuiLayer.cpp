@@ -1,6 +1,10 @@
 #include "engine/ImGuiLayer.h"
 #include "engine/Log.h"
+#include "engine/renderer/GpuProfiler.h"
+#include "engine/renderer/RenderCommand.h"
+#include "engine/renderer/RenderCounters.h"
 #include <GLFW/glfw3.h>
+#include <cstring>
 #include <imgui.h>
 
 #include "examples/imgui_impl_glfw.h"
@@ -27,7 +31,8 @@ void ImGuiLayer::OnAttach() {
 
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-    io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+    if (!threaded_)
+        io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 
     // Setup Dear ImGui style
     ImGui::StyleColorsDark();
@@ -44,11 +49,22 @@ void ImGuiLayer::OnAttach() {
     const char* glsl_version = "#version 330 core";
     ImGui_ImplGlfw_InitForOpenGL(window_, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
+
+    // NewFrame creates these lazily, which would be a GL call without a context once the
+    // render thread owns it
+    if (threaded_)
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+
+    togglePerformanceAction_ =
+        Input::RegisterAction("TogglePerformancePanel", {InputBinding::Key(GLFW_KEY_F3)});
 }
 
 void ImGuiLayer::OnDetach() {
     SE_LOG_INFO("ImGuiLayer::OnDetach");
 
+    for (auto& snapshot : snapshots_)
+        FreeSnapshot(snapshot);
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -62,9 +78,25 @@ void ImGuiLayer::OnRender() {
     // Rendering is handled by Begin/End
 }
 
-void ImGuiLayer::OnEvent(Event& event) {
-    // You can block events here if ImGui wants to capture them
-    // For now, we let them pass through
+void ImGuiLayer::OnImGuiRender() {
+    if (Input::IsActionPressed(togglePerformanceAction_))
+        performancePanel_.SetOpen(!performancePanel_.IsOpen());
+
+    performancePanel_.OnImGuiRender();
+}
+
+void ImGuiLayer::OnEvents(EventQueue& events) {
+    // ImGui sees raw GLFW input through its own callbacks; here it only keeps what it
+    // captured (hovered windows, focused text fields) from the layers below
+    const ImGuiIO& io = ImGui::GetIO();
+    if (!io.WantCaptureMouse && !io.WantCaptureKeyboard)
+        return;
+
+    events.ForEach([&io](Event& event) {
+        if ((event.IsMouse() && io.WantCaptureMouse) ||
+            (event.IsKeyboard() && io.WantCaptureKeyboard))
+            event.Handled = true;
+    });
 }
 
 void ImGuiLayer::Begin() {
@@ -73,9 +105,43 @@ void ImGuiLayer::Begin() {
     ImGui::NewFrame();
 }
 
+// The OpenGL backend issues its GL calls directly; count what it will do with the draw data
+static void CountDrawData(const ImDrawData* drawData) {
+    PassCounters& counters = RenderCounters::Active();
+    counters.ProgramBinds++;
+    counters.VertexArrayBinds++;
+    for (int i = 0; i < drawData->CmdListsCount; ++i) {
+        const ImDrawList* list = drawData->CmdLists[i];
+        counters.BufferUploads += 2;
+        counters.BufferBytes += list->VtxBuffer.size_in_bytes() + list->IdxBuffer.size_in_bytes();
+        for (const ImDrawCmd& cmd : list->CmdBuffer) {
+            if (cmd.UserCallback)
+                continue;
+            counters.DrawCalls++;
+            counters.TextureBinds++;
+            counters.Triangles += cmd.ElemCount / 3;
+        }
+    }
+}
+
 void ImGuiLayer::End() {
     ImGui::Render();
+
+    if (threaded_) {
+        DrawDataSnapshot& snapshot = snapshots_[snapshotIndex_];
+        snapshotIndex_ = (snapshotIndex_ + 1) % snapshots_.size();
+        CaptureDrawData(snapshot);
+        GpuProfiler::BeginPass(GpuPass::ImGui);
+        CountDrawData(&snapshot.Data);
+        RenderCommand::Callback(&ImGuiLayer::RenderSnapshot, &snapshot);
+        GpuProfiler::EndPass(GpuPass::ImGui);
+        return;
+    }
+
+    GpuProfiler::BeginPass(GpuPass::ImGui);
+    CountDrawData(ImGui::GetDrawData());
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    GpuProfiler::EndPass(GpuPass::ImGui);
 
     ImGuiIO& io = ImGui::GetIO();
     if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
@@ -86,4 +152,47 @@ void ImGuiLayer::End() {
     }
 }
 
+template <typename T>
+static void CopyImVector(ImVector<T>& dst, const ImVector<T>& src) {
+    // resize() keeps the capacity (operator= would free it first)
+    dst.resize(src.Size);
+    if (src.Size > 0)
+        memcpy(dst.Data, src.Data, src.size_in_bytes());
+}
+
+void ImGuiLayer::CaptureDrawData(DrawDataSnapshot& snapshot) {
+    ImDrawData* drawData = ImGui::GetDrawData();
+
+    // Reuse the snapshot's draw lists and their buffers, so once they have grown to the
+    // UI's size capturing no longer allocates
+    while (snapshot.Lists.Size < drawData->CmdListsCount)
+        snapshot.Lists.push_back(IM_NEW(ImDrawList)(drawData->CmdLists[0]->_Data));
+    for (int i = 0; i < drawData->CmdListsCount; ++i) {
+        const ImDrawList* src = drawData->CmdLists[i];
+        ImDrawList* dst = snapshot.Lists[i];
+        CopyImVector(dst->CmdBuffer, src->CmdBuffer);
+        CopyImVector(dst->IdxBuffer, src->IdxBuffer);
+        CopyImVector(dst->VtxBuffer, src->VtxBuffer);
+        dst->Flags = src->Flags;
+    }
+
+    snapshot.Data = *drawData;
+
+    snapshot.Data.CmdLists = snapshot.Lists.Data;
+    snapshot.Data.OwnerViewport = nullptr;
+}
+
+void ImGuiLayer::FreeSnapshot(DrawDataSnapshot& snapshot) {
+    for (ImDrawList* list : snapshot.Lists)
+        IM_DELETE(list);
+    snapshot.Lists.clear();
+    snapshot.Data.Clear();
+}
+
+void ImGuiLayer::RenderSnapshot(void* snapshot) {
+    auto* data = static_cast<DrawDataSnapshot*>(snapshot);
+    if (data->Data.Valid)
+        ImGui_ImplOpenGL3_RenderDrawData(&data->Data);
+}
+
 } // namespace se
\ No newline at end of file
@@ -1,43 +1,203 @@
 #include "engine/Input.h"
+#include "engine/EventQueue.h"
+#include "engine/Log.h"
 #include <GLFW/glfw3.h>
 
 namespace se {
 
+static_assert(GLFW_KEY_LAST < Input::kKeyCount, "Input key bits too small");
+static_assert(GLFW_MOUSE_BUTTON_LAST < Input::kMouseButtonCount, "Input mouse bits too small");
+
 GLFWwindow* Input::window_ = nullptr;
 
+Input::State Input::live_;
+std::bitset<Input::kKeyCount> Input::tappedKeys_;
+std::bitset<Input::kMouseButtonCount> Input::tappedButtons_;
+Input::State Input::current_;
+Input::State Input::previous_;
+
+std::vector<Input::Action> Input::actions_;
+std::bitset<Input::kMaxActions> Input::currentActions_;
+std::bitset<Input::kMaxActions> Input::previousActions_;
+
 void Input::SetWindow(GLFWwindow* window) {
     window_ = window;
+    live_ = current_ = previous_ = State{};
+    tappedKeys_.reset();
+    tappedButtons_.reset();
+
+    if (!window_)
+        return;
+
+    double xpos, ypos;
+    glfwGetCursorPos(window_, &xpos, &ypos);
+    live_.Cursor = {static_cast<float>(xpos), static_cast<float>(ypos)};
+}
+
+void Input::ApplyEvents(const EventQueue& events) {
+    // Raw events: a layer handling one doesn't hide it from input state
+    events.ForEachRaw([](const Event& event) {
+        switch (event.Type) {
+        case EventType::KeyPressed:
+            if (event.Key.Code >= 0 && event.Key.Code < (int)kKeyCount && !event.Key.Repeat) {
+                live_.Keys.set(event.Key.Code);
+                tappedKeys_.set(event.Key.Code);
+            }
+            break;
+        case EventType::KeyReleased:
+            if (event.Key.Code >= 0 && event.Key.Code < (int)kKeyCount)
+                live_.Keys.reset(event.Key.Code);
+            break;
+        case EventType::MouseButtonPressed:
+            if (event.MouseButton.Button >= 0 &&
+                event.MouseButton.Button < (int)kMouseButtonCount) {
+                live_.MouseButtons.set(event.MouseButton.Button);
+                tappedButtons_.set(event.MouseButton.Button);
+            }
+            break;
+        case EventType::MouseButtonReleased:
+            if (event.MouseButton.Button >= 0 &&
+                event.MouseButton.Button < (int)kMouseButtonCount)
+                live_.MouseButtons.reset(event.MouseButton.Button);
+            break;
+        case EventType::MouseMoved:
+            live_.Cursor = {event.Mouse.X, event.Mouse.Y};
+            break;
+        case EventType::MouseScrolled:
+            live_.Scroll += glm::vec2(event.Mouse.X, event.Mouse.Y);
+            break;
+        default:
+            break;
+        }
+    });
+}
+
+void Input::BeginFrame() {
+    previous_ = current_;
+
+    current_.Keys = live_.Keys | tappedKeys_;
+    current_.MouseButtons = live_.MouseButtons | tappedButtons_;
+    current_.Cursor = live_.Cursor;
+    current_.Scroll = live_.Scroll;
+    live_.Scroll = glm::vec2(0.0f);
+    tappedKeys_.reset();
+    tappedButtons_.reset();
+
+    previousActions_ = currentActions_;
+    currentActions_.reset();
+    for (size_t i = 0; i < actions_.size(); ++i) {
+        for (const InputBinding& binding : actions_[i].Bindings) {
+            bool down = binding.Source == InputBinding::Device::Keyboard
+                            ? IsKeyDown(binding.Code)
+                            : IsMouseButtonDown(binding.Code);
+            if (down) {
+                currentActions_.set(i);
+                break;
+            }
+        }
+    }
 }
 
 bool Input::IsKeyPressed(int keycode) {
-    if (!window_)
+    if (keycode < 0 || keycode >= (int)kKeyCount)
+        return false;
+    return current_.Keys[keycode] && !previous_.Keys[keycode];
+}
+
+bool Input::IsKeyDown(int keycode) {
+    if (keycode < 0 || keycode >= (int)kKeyCount)
+        return false;
+    return current_.Keys[keycode];
+}
+
+bool Input::IsKeyReleased(int keycode) {
+    if (keycode < 0 || keycode >= (int)kKeyCount)
         return false;
-    int state = glfwGetKey(window_, keycode);
-    return state == GLFW_PRESS || state == GLFW_REPEAT;
+    return !current_.Keys[keycode] && previous_.Keys[keycode];
 }
 
 bool Input::IsMouseButtonPressed(int button) {
-    if (!window_)
+    if (button < 0 || button >= (int)kMouseButtonCount)
+        return false;
+    return current_.MouseButtons[button] && !previous_.MouseButtons[button];
+}
+
+bool Input::IsMouseButtonDown(int button) {
+    if (button < 0 || button >= (int)kMouseButtonCount)
         return false;
-    int state = glfwGetMouseButton(window_, button);
-    return state == GLFW_PRESS;
+    return current_.MouseButtons[button];
+}
+
+bool Input::IsMouseButtonReleased(int button) {
+    if (button < 0 || button >= (int)kMouseButtonCount)
+        return false;
+    return !current_.MouseButtons[button] && previous_.MouseButtons[button];
 }
 
 glm::vec2 Input::GetMousePosition() {
-    if (!window_)
-        return {0.0f, 0.0f};
-    double xpos, ypos;
-    glfwGetCursorPos(window_, &xpos, &ypos);
-    SE_LOG_DEBUG("Mouse position: ({}, {})", xpos, ypos);
-    return {static_cast<float>(xpos), static_cast<float>(ypos)};
+    return current_.Cursor;
 }
 
 float Input::GetMouseX() {
-    return GetMousePosition().x;
+    return current_.Cursor.x;
 }
 
 float Input::GetMouseY() {
-    return GetMousePosition().y;
+    return current_.Cursor.y;
+}
+
+glm::vec2 Input::GetMouseScroll() {
+    return current_.Scroll;
+}
+
+InputAction Input::RegisterAction(const std::string& name,
+                                  const std::vector<InputBinding>& bindings) {
+    InputAction action = GetAction(name);
+    if (action != kInvalidInputAction) {
+        actions_[action].Bindings = bindings;
+        return action;
+    }
+
+    if (actions_.size() >= kMaxActions) {
+        SE_LOG_ERROR("Input: cannot register action '{}', limit of {} reached", name,
+                     kMaxActions);
+        return kInvalidInputAction;
+    }
+
+    actions_.push_back({name, bindings});
+    return static_cast<InputAction>(actions_.size() - 1);
+}
+
+InputAction Input::GetAction(const std::string& name) {
+    for (size_t i = 0; i < actions_.size(); ++i) {
+        if (actions_[i].Name == name)
+            return static_cast<InputAction>(i);
+    }
+    return kInvalidInputAction;
+}
+
+void Input::ClearActions() {
+    actions_.clear();
+    currentActions_.reset();
+    previousActions_.reset();
+}
+
+bool Input::IsActionPressed(InputAction action) {
+    if (action >= kMaxActions)
+        return false;
+    return currentActions_[action] && !previousActions_[action];
+}
+
+bool Input::IsActionDown(InputAction action) {
+    if (action >= kMaxActions)
+        return false;
+    return currentActions_[action];
+}
+
+bool Input::IsActionReleased(InputAction action) {
+    if (action >= kMaxActions)
+        return false;
+    return !currentActions_[action] && previousActions_[action];
 }
 
-} // namespace se
\ No newline at end of file
+} // namespace se
@@ -1,3 +1,4 @@
+#include <engine/Input.h>
 #include <engine/InputHandler.h>
 #include <engine/Log.h>
 #include <iostream>
@@ -16,7 +17,8 @@ void InputHandler::processKeyboard(GLFWwindow* window, float deltaTime) {
     if (!camera_)
         return;
 
-    const auto isPressed = [window](int key) { return glfwGetKey(window, key) == GLFW_PRESS; };
+    // Held keys from the frame's input snapshot
+    const auto isPressed = [](int key) { return se::Input::IsKeyDown(key); };
 
     camera_->processKeyboard(deltaTime,
                              isPressed(GLFW_KEY_W),             // forward
@@ -52,6 +54,13 @@ void InputHandler::processMouseScroll(double xpos, double ypos) {
     camera_->processMouseScroll(static_cast<float>(xpos), static_cast<float>(ypos));
 }
 
+void InputHandler::processEvent(const se::Event& event) {
+    if (event.Type == se::EventType::MouseMoved)
+        processMousePosition(event.Mouse.X, event.Mouse.Y);
+    else if (event.Type == se::EventType::MouseScrolled)
+        processMouseScroll(event.Mouse.X, event.Mouse.Y);
+}
+
 void InputHandler::setCursorModeFromString(GLFWwindow* window, const std::string& modeString) {
     auto it = stringToCursorMode.find(modeString);
 
@@ -65,13 +74,7 @@ void InputHandler::setCursorModeFromString(GLFWwindow* window, const std::string
 }
 
 void InputHandler::setupMouseCapture(GLFWwindow* window) {
-    glfwSetWindowUserPointer(window, this);
-
-    // mouse position
-    glfwSetCursorPosCallback(window, mousePositionCallback);
-
-    // mouse scroll
-    glfwSetScrollCallback(window, mouseScrollCallback);
+    // Mouse position and scroll arrive as events through processEvent
 
     // mouse input mode
     setCursorModeFromString(window, "hidden");
@@ -0,0 +1,210 @@
+#include "engine/InputRecorder.h"
+#include "engine/Input.h"
+#include "engine/Log.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace se {
+
+namespace {
+
+constexpr char kMagic[4] = {'S', 'E', 'I', 'R'};
+constexpr uint32_t kVersion = 1;
+
+struct FileHeader {
+    char Magic[4];
+    uint32_t Version;
+    uint32_t FrameCount;
+    uint32_t Reserved;
+};
+
+// Per-frame flags: which optional blocks follow the timestep
+enum FrameFlags : uint8_t {
+    kCursorChanged = 1 << 0,
+    kScrolled = 1 << 1,
+    kButtonsChanged = 1 << 2,
+    kKeysChanged = 1 << 3,
+};
+
+template <typename T>
+void Append(std::vector<uint8_t>& data, const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool Read(const std::vector<uint8_t>& data, size_t& offset, T& value) {
+    if (offset + sizeof(T) > data.size())
+        return false;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+InputRecorder::~InputRecorder() {
+    Stop();
+}
+
+void InputRecorder::BeginRecording(const std::string& path) {
+    mode_ = Mode::Recording;
+    path_ = path;
+    data_.clear();
+    frameIndex_ = frameCount_ = 0;
+    previous_ = InputFrame{};
+
+    SE_LOG_INFO("Recording input to {}", path_);
+}
+
+void InputRecorder::BeginPlayback(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Failed to open input recording: " + path);
+
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+
+    FileHeader header{};
+    size_t offset = 0;
+    if (!Read(bytes, offset, header) || std::memcmp(header.Magic, kMagic, 4) != 0)
+        throw std::runtime_error("Not an input recording: " + path);
+    if (header.Version != kVersion)
+        throw std::runtime_error("Unsupported input recording version in " + path);
+
+    mode_ = Mode::Playback;
+    path_ = path;
+    data_.assign(bytes.begin() + offset, bytes.end());
+    readOffset_ = 0;
+    frameIndex_ = 0;
+    frameCount_ = header.FrameCount;
+    previous_ = InputFrame{};
+
+    SE_LOG_INFO("Replaying {} frame(s) of input from {}", frameCount_, path_);
+}
+
+void InputRecorder::Stop() {
+    if (mode_ == Mode::Recording)
+        WriteFile();
+    mode_ = Mode::None;
+}
+
+void InputRecorder::CaptureFrame(float timestep) {
+    if (mode_ != Mode::Recording)
+        return;
+
+    InputFrame frame;
+    frame.Timestep = timestep;
+
+    // Taken from the frame's snapshot (Input::BeginFrame runs first)
+    frame.Cursor = Input::GetMousePosition();
+    frame.Scroll = Input::GetMouseScroll();
+
+    for (int button = 0; button < (int)Input::kMouseButtonCount; ++button) {
+        if (Input::IsMouseButtonDown(button))
+            frame.MouseButtons |= uint8_t(1u << button);
+    }
+
+    for (int key = 0; key < (int)Input::kKeyCount; ++key) {
+        if (Input::IsKeyDown(key))
+            frame.Keys[key >> 3] |= uint8_t(1u << (key & 7));
+    }
+
+    uint8_t flags = 0;
+    if (frameCount_ == 0 || frame.Cursor != previous_.Cursor)
+        flags |= kCursorChanged;
+    if (frame.Scroll != glm::vec2(0.0f))
+        flags |= kScrolled;
+    if (frame.MouseButtons != previous_.MouseButtons)
+        flags |= kButtonsChanged;
+    if (frame.Keys != previous_.Keys)
+        flags |= kKeysChanged;
+
+    Append(data_, flags);
+    Append(data_, frame.Timestep);
+    if (flags & kCursorChanged)
+        Append(data_, frame.Cursor);
+    if (flags & kScrolled)
+        Append(data_, frame.Scroll);
+    if (flags & kButtonsChanged)
+        Append(data_, frame.MouseButtons);
+    if (flags & kKeysChanged)
+        Append(data_, frame.Keys);
+
+    previous_ = frame;
+    frameCount_++;
+}
+
+bool InputRecorder::PlaybackFrame(float& timestep, EventQueue& events) {
+    if (mode_ != Mode::Playback || frameIndex_ >= frameCount_)
+        return false;
+
+    InputFrame frame = previous_;
+    frame.Scroll = glm::vec2(0.0f);
+
+    uint8_t flags = 0;
+    bool ok = Read(data_, readOffset_, flags) && Read(data_, readOffset_, frame.Timestep);
+    if (ok && (flags & kCursorChanged))
+        ok = Read(data_, readOffset_, frame.Cursor);
+    if (ok && (flags & kScrolled))
+        ok = Read(data_, readOffset_, frame.Scroll);
+    if (ok && (flags & kButtonsChanged))
+        ok = Read(data_, readOffset_, frame.MouseButtons);
+    if (ok && (flags & kKeysChanged))
+        ok = Read(data_, readOffset_, frame.Keys);
+
+    if (!ok) {
+        SE_LOG_WARN("Input recording {} is truncated at frame {}", path_, frameIndex_);
+        frameCount_ = frameIndex_;
+        return false;
+    }
+
+    // Replay the differences as the events the window would have produced
+    if (flags & kKeysChanged) {
+        for (int key = 0; key < (int)Input::kKeyCount; ++key) {
+            bool down = frame.IsKeyDown(key);
+            if (down != previous_.IsKeyDown(key))
+                events.Push(Event::KeyChanged(key, down));
+        }
+    }
+    if (flags & kButtonsChanged) {
+        for (int button = 0; button < (int)Input::kMouseButtonCount; ++button) {
+            bool down = frame.IsMouseButtonDown(button);
+            if (down != previous_.IsMouseButtonDown(button))
+                events.Push(Event::MouseButtonChanged(button, down));
+        }
+    }
+    if (flags & kCursorChanged)
+        events.Push(Event::MouseMoved(frame.Cursor.x, frame.Cursor.y));
+    if (flags & kScrolled)
+        events.Push(Event::MouseScrolled(frame.Scroll.x, frame.Scroll.y));
+
+    previous_ = frame;
+    frameIndex_++;
+
+    timestep = frame.Timestep;
+    return true;
+}
+
+void InputRecorder::WriteFile() {
+    std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        SE_LOG_ERROR("Failed to write input recording {}", path_);
+        return;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.Magic, kMagic, 4);
+    header.Version = kVersion;
+    header.FrameCount = frameCount_;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data_.data()), (std::streamsize)data_.size());
+
+    SE_LOG_INFO("Wrote {} frame(s) of input ({} bytes) to {}", frameCount_,
+                sizeof(header) + data_.size(), path_);
+}
+
+} // namespace se
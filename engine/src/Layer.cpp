@@ -1,7 +1,9 @@
 #include "engine/Layer.h"
+#include "engine/Profiler.h"
 
 namespace se {
 
-Layer::Layer(const std::string& name) : debugName_(name) {}
+Layer::Layer(const std::string& name)
+    : debugName_(name), profileName_(Profiler::InternName(name)) {}
 
 } // namespace se
\ No newline at end of file
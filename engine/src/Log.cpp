@@ -1,10 +1,12 @@
 
 #include <engine/Log.h>
+#include <spdlog/sinks/ringbuffer_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace se {
 static std::shared_ptr<spdlog::logger> g_logger;
+static std::shared_ptr<spdlog::sinks::ringbuffer_sink_mt> g_recentLines;
 
 void LogInit(bool toFile) {
     std::vector<spdlog::sink_ptr> sinks;
@@ -15,6 +17,9 @@ void LogInit(bool toFile) {
                                                                                1024 * 1024 * 5, 3));
     }
 
+    g_recentLines = std::make_shared<spdlog::sinks::ringbuffer_sink_mt>(kRecentLogLines);
+    sinks.push_back(g_recentLines);
+
     g_logger = std::make_shared<spdlog::logger>("engine", begin(sinks), end(sinks));
     spdlog::register_logger(g_logger);
 #ifdef DEBUG
@@ -28,4 +33,10 @@ void LogInit(bool toFile) {
 std::shared_ptr<spdlog::logger>& Logger() {
     return g_logger;
 }
+
+std::vector<std::string> GetRecentLogLines() {
+    if (!g_recentLines)
+        return {};
+    return g_recentLines->last_formatted();
+}
 } // namespace se
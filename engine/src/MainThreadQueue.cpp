@@ -0,0 +1,101 @@
+#include "engine/MainThreadQueue.h"
+#include "engine/Log.h"
+#include <chrono>
+#include <limits>
+
+namespace se {
+
+MainThreadQueue* MainThreadQueue::s_Instance = nullptr;
+
+MainThreadQueue::MainThreadQueue() {
+    if (s_Instance) {
+        SE_LOG_WARN("MainThreadQueue already exists; MainThreadQueue::Get() keeps the first one");
+        return;
+    }
+    s_Instance = this;
+}
+
+MainThreadQueue::~MainThreadQueue() {
+    if (s_Instance == this)
+        s_Instance = nullptr;
+}
+
+void MainThreadQueue::Enqueue(Task task, TaskPriority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queues_[static_cast<size_t>(priority)].push_back(std::move(task));
+}
+
+void MainThreadQueue::Drain() {
+    Run(budgetMs_);
+}
+
+void MainThreadQueue::Flush() {
+    Run(std::numeric_limits<float>::infinity());
+}
+
+void MainThreadQueue::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& queue : queues_)
+        queue.clear();
+}
+
+uint32_t MainThreadQueue::GetBacklog() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& queue : queues_)
+        count += queue.size();
+    return static_cast<uint32_t>(count);
+}
+
+void MainThreadQueue::Run(float budgetMs) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto elapsedMs = [start]() {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    };
+
+    stats_ = {};
+    stats_.BudgetMs = budgetMs;
+
+    Task task;
+    TaskPriority priority;
+    while (Pop(task, priority)) {
+        TaskStatus status = TaskStatus::Done;
+        try {
+            status = task();
+        } catch (const std::exception& e) {
+            SE_LOG_ERROR("Unhandled exception in main-thread task: {}", e.what());
+        }
+        stats_.StepsRun++;
+
+        if (status == TaskStatus::Continue) {
+            // Resume before newer work of the same priority so tasks finish in order
+            std::lock_guard<std::mutex> lock(mutex_);
+            queues_[static_cast<size_t>(priority)].push_front(std::move(task));
+        } else {
+            stats_.TasksCompleted++;
+        }
+
+        if (elapsedMs() >= budgetMs)
+            break;
+    }
+
+    stats_.TimeMs = elapsedMs();
+    stats_.Backlog = GetBacklog();
+}
+
+bool MainThreadQueue::Pop(Task& task, TaskPriority& priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        if (queues_[i].empty())
+            continue;
+
+        task = std::move(queues_[i].front());
+        queues_[i].pop_front();
+        priority = static_cast<TaskPriority>(i);
+        return true;
+    }
+    return false;
+}
+
+} // namespace se
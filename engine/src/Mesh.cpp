@@ -1,9 +1,8 @@
 #include "engine/Mesh.h"
+#include "engine/renderer/RenderCounters.h"
 
 Mesh::Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices)
-    : vertices_(vertices), indices_(indices) {
-    setupMesh();
-}
+    : vertices_(vertices), indices_(indices) {}
 
 Mesh::Mesh(Mesh&& other) noexcept
     : vertices_(std::move(other.vertices_)), indices_(std::move(other.indices_)), vao_(other.vao_),
@@ -46,7 +45,7 @@ Mesh::~Mesh() {
         glDeleteBuffers(1, &ebo_);
 }
 
-void Mesh::setupMesh() {
+void Mesh::setupMesh() const {
     // Generate buffers
     glGenVertexArrays(1, &vao_);
     glGenBuffers(1, &vbo_);
@@ -64,6 +63,8 @@ void Mesh::setupMesh() {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(unsigned int), indices_.data(),
                  GL_STATIC_DRAW);
+    se::RenderCounters::AddBufferUpload(vertices_.size() * sizeof(float));
+    se::RenderCounters::AddBufferUpload(indices_.size() * sizeof(unsigned int));
 
     // Vertex attributes
     // Position attribute (location = 0, 3 floats)
@@ -83,6 +84,9 @@ void Mesh::setupMesh() {
 }
 
 void Mesh::draw() const {
+    if (!vao_)
+        setupMesh();
+
     glBindVertexArray(vao_);
     glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices_.size()), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
@@ -2,9 +2,8 @@
 #include <array>
 #include <cmath>
 
-// Anonymous namespace to hold helper for computing normals
-namespace {
-static void addNormals(std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+void MeshFactory::addNormals(std::vector<float>& vertices,
+                             const std::vector<unsigned int>& indices) {
     const size_t vertexCount = vertices.size() / 6; // pos+color per vertex
     std::vector<std::array<float, 3>> normals(vertexCount, {0.f, 0.f, 0.f});
 
@@ -73,7 +72,6 @@ static void addNormals(std::vector<float>& vertices, const std::vector<unsigned
 
     vertices.swap(newVerts);
 }
-} // namespace
 
 void MeshFactory::addVertex(std::vector<float>& vertices, float x, float y, float z, float r,
                             float g, float b) {
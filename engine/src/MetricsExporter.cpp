@@ -0,0 +1,303 @@
+#include "engine/MetricsExporter.h"
+#include "engine/Log.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/socket.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+#    define SE_METRICS_UNIX 1
+#endif
+
+namespace se {
+
+namespace {
+
+constexpr std::string_view kSocketPrefix = "unix:";
+constexpr uint64_t kFlushIntervalNs = 1'000'000'000;
+constexpr uint64_t kReconnectIntervalNs = 5'000'000'000;
+
+// Everything but the frame record that goes into a line
+struct FrameExtras {
+    double TimeSeconds = 0.0;
+    uint64_t LiveAllocations = 0;
+    uint64_t ResidentBytes = 0;
+};
+
+// The single list of columns; `emit(name, value)` gets a float or an integer
+template <typename Emit>
+void ForEachMetric(const FrameRecord& record, const FrameExtras& extras, Emit&& emit) {
+    const RenderStats& render = record.Render;
+    const FrameCounters& counters = render.Counters;
+    PassCounters total = counters.Total();
+    AllocationCounters allocations = record.Allocations.Total();
+
+    emit("frame", record.Index);
+    emit("time_s", extras.TimeSeconds);
+    emit("frame_ms", record.FrameMs);
+    emit("input_ms", record.GetPhase(FramePhase::Input));
+    emit("fixed_update_ms", record.GetPhase(FramePhase::FixedUpdate));
+    emit("update_ms", record.GetPhase(FramePhase::Update));
+    emit("render_ms", record.GetPhase(FramePhase::Render));
+    emit("main_thread_queue_ms", record.GetPhase(FramePhase::MainThreadQueue));
+    emit("imgui_ms", record.GetPhase(FramePhase::ImGui));
+    emit("submit_ms", record.GetPhase(FramePhase::Submit));
+    emit("wait_ms", record.GetPhase(FramePhase::Wait));
+    emit("cpu_shadow_ms", render.ShadowPassMs);
+    emit("cpu_scene_ms", render.ScenePassMs);
+    emit("gpu_shadow_ms", render.GpuPasses[size_t(GpuPass::Shadow)].Milliseconds);
+    emit("gpu_scene_ms", render.GpuPasses[size_t(GpuPass::Scene)].Milliseconds);
+    emit("gpu_imgui_ms", render.GpuPasses[size_t(GpuPass::ImGui)].Milliseconds);
+    emit("input_to_submit_ms", render.InputToSubmitMs);
+    emit("fence_wait_ms", render.FenceWaitMs);
+    emit("draw_calls", total.DrawCalls);
+    emit("triangles", total.Triangles);
+    emit("program_binds", total.ProgramBinds);
+    emit("vertex_array_binds", total.VertexArrayBinds);
+    emit("texture_binds", total.TextureBinds);
+    emit("framebuffer_binds", total.FramebufferBinds);
+    emit("uniform_uploads", total.UniformUploads);
+    emit("uniform_bytes", total.UniformBytes);
+    emit("buffer_uploads", total.BufferUploads);
+    emit("buffer_bytes", total.BufferBytes);
+    emit("objects_submitted", counters.ObjectsSubmitted);
+    emit("objects_culled", counters.ObjectsCulled);
+    emit("entities", counters.Entities);
+    emit("allocations", allocations.Count);
+    emit("allocated_bytes", allocations.Bytes);
+    emit("frees", record.Allocations.Frees);
+    emit("live_allocations", extras.LiveAllocations);
+    emit("resident_bytes", extras.ResidentBytes);
+}
+
+template <typename T>
+void AppendValue(fmt::memory_buffer& buffer, T value) {
+    if constexpr (std::is_floating_point_v<T>)
+        fmt::format_to(std::back_inserter(buffer), "{:.3f}", value);
+    else
+        fmt::format_to(std::back_inserter(buffer), "{}", value);
+}
+
+uint64_t ReadResidentBytes(int statmFd) {
+#ifdef SE_METRICS_UNIX
+    // "size resident shared ..." in pages
+    char text[128];
+    ssize_t length = statmFd >= 0 ? pread(statmFd, text, sizeof(text) - 1, 0) : -1;
+    if (length <= 0)
+        return 0;
+    text[length] = '\0';
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    if (std::sscanf(text, "%llu %llu", &size, &resident) != 2)
+        return 0;
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    (void)statmFd;
+    return 0;
+#endif
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter(const MetricsExporterSpec& spec) : spec_(spec) {
+    spec_.Interval = std::max(spec_.Interval, 1u);
+    if (std::string_view(spec_.Output).starts_with(kSocketPrefix))
+        socketPath_ = spec_.Output.substr(kSocketPrefix.size());
+
+#ifdef SE_METRICS_UNIX
+    statmFd_ = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+#endif
+    startNs_ = Profiler::Now();
+    lastFlushNs_ = startNs_;
+    lastConnectNs_ = startNs_;
+    if (Open()) {
+        SE_LOG_INFO("Exporting frame metrics to '{}'", spec_.Output);
+    } else if (!socketPath_.empty()) {
+        SE_LOG_WARN("Metrics socket '{}' isn't listening yet; retrying every {} s", socketPath_,
+                    kReconnectIntervalNs / 1'000'000'000);
+    }
+}
+
+MetricsExporter::~MetricsExporter() {
+    Close();
+#ifdef SE_METRICS_UNIX
+    if (statmFd_ >= 0)
+        close(statmFd_);
+#endif
+}
+
+void MetricsExporter::AddFrame(const FrameRecord& record) {
+    if (record.Index % spec_.Interval != 0)
+        return;
+
+    if (!file_ && socket_ < 0) {
+        // Only sockets are retried; the dashboard may start after the engine
+        if (socketPath_.empty() || record.EndNs - lastConnectNs_ < kReconnectIntervalNs)
+            return;
+        lastConnectNs_ = record.EndNs;
+        if (!Open())
+            return;
+        SE_LOG_INFO("Metrics socket '{}' connected", socketPath_);
+    }
+
+    FrameExtras extras;
+    extras.TimeSeconds = (record.EndNs - startNs_) / 1.0e9;
+    AllocationFrameStats totals = AllocationTracker::GetTotals();
+    AllocationCounters allocated = totals.Total();
+    extras.LiveAllocations = allocated.Count > totals.Frees ? allocated.Count - totals.Frees : 0;
+    extras.ResidentBytes = ReadResidentBytes(statmFd_);
+
+    buffer_.clear();
+    if (spec_.Format == MetricsFormat::Csv) {
+        bool first = true;
+        ForEachMetric(record, extras, [&](const char*, auto value) {
+            if (!first)
+                buffer_.push_back(',');
+            first = false;
+            AppendValue(buffer_, value);
+        });
+    } else {
+        buffer_.push_back('{');
+        ForEachMetric(record, extras, [&](const char* name, auto value) {
+            if (buffer_.size() > 1)
+                buffer_.push_back(',');
+            fmt::format_to(std::back_inserter(buffer_), "\"{}\":", name);
+            AppendValue(buffer_, value);
+        });
+        buffer_.push_back('}');
+    }
+    buffer_.push_back('\n');
+
+    bool flush = record.EndNs - lastFlushNs_ >= kFlushIntervalNs;
+    if (flush)
+        lastFlushNs_ = record.EndNs;
+    if (Write(flush))
+        exported_++;
+}
+
+bool MetricsExporter::Open() {
+    if (socketPath_.empty()) {
+        file_ = std::fopen(spec_.Output.c_str(), "w");
+        if (!file_) {
+            SE_LOG_ERROR("Failed to open metrics file '{}': {}", spec_.Output,
+                         std::strerror(errno));
+            return false;
+        }
+        WriteHeader();
+        return true;
+    }
+
+#ifdef SE_METRICS_UNIX
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(address.sun_path)) {
+        SE_LOG_ERROR("Metrics socket path '{}' is too long", socketPath_);
+        return false;
+    }
+    std::memcpy(address.sun_path, socketPath_.c_str(), socketPath_.size() + 1);
+
+    socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_ >= 0 && connect(socket_, reinterpret_cast<const sockaddr*>(&address),
+                                sizeof(address)) == 0) {
+        // Non-blocking from here on: a slow reader drops lines instead of stalling frames
+        fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL) | O_NONBLOCK);
+        fcntl(socket_, F_SETFD, FD_CLOEXEC);
+#    ifdef SO_NOSIGPIPE
+        int enable = 1;
+        setsockopt(socket_, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#    endif
+        WriteHeader();
+        return socket_ >= 0;
+    }
+    Close();
+#else
+    SE_LOG_ERROR("Metrics sockets need a Unix platform");
+#endif
+    return false;
+}
+
+void MetricsExporter::Close() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+#ifdef SE_METRICS_UNIX
+    if (socket_ >= 0) {
+        close(socket_);
+        socket_ = -1;
+    }
+#endif
+}
+
+void MetricsExporter::WriteHeader() {
+    if (spec_.Format != MetricsFormat::Csv)
+        return;
+
+    buffer_.clear();
+    ForEachMetric(FrameRecord{}, FrameExtras{}, [&](const char* name, auto) {
+        if (buffer_.size() > 0)
+            buffer_.push_back(',');
+        buffer_.append(std::string_view(name));
+    });
+    buffer_.push_back('\n');
+    Write(true);
+}
+
+bool MetricsExporter::Write(bool flush) {
+    if (file_) {
+        std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        if (flush)
+            std::fflush(file_);
+        return true;
+    }
+
+#ifdef SE_METRICS_UNIX
+    if (socket_ < 0)
+        return false;
+
+    // The rest of a partially sent line goes first, or the reader would see a torn line
+    if (!pendingTail_.empty()) {
+        if (!Send(pendingTail_.data(), pendingTail_.size()))
+            return false;
+        pendingTail_.clear();
+    }
+    return Send(buffer_.data(), buffer_.size());
+#else
+    return false;
+#endif
+}
+
+bool MetricsExporter::Send(const char* data, size_t size) {
+#ifdef SE_METRICS_UNIX
+#    ifdef MSG_NOSIGNAL
+    constexpr int kSendFlags = MSG_NOSIGNAL;
+#    else
+    constexpr int kSendFlags = 0;
+#    endif
+    ssize_t sent = send(socket_, data, size, kSendFlags);
+    if (sent == static_cast<ssize_t>(size))
+        return true;
+
+    if (sent >= 0) {
+        pendingTail_.assign(data + sent, size - sent);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        dropped_++;
+    } else {
+        SE_LOG_WARN("Metrics socket '{}' closed; retrying", socketPath_);
+        pendingTail_.clear();
+        Close();
+    }
+#else
+    (void)data;
+    (void)size;
+#endif
+    return false;
+}
+
+} // namespace se
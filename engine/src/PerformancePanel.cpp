@@ -0,0 +1,485 @@
+#include "engine/PerformancePanel.h"
+#include "engine/FrameStats.h"
+#include "engine/HardwareCounters.h"
+#include "engine/memory/AllocationTracker.h"
+#include "engine/renderer/GpuProfiler.h"
+#include "engine/renderer/RenderCounters.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <imgui.h>
+#include <unordered_map>
+
+namespace se {
+
+namespace {
+
+struct ScopeBar {
+    const ProfileEvent* Event;
+    uint32_t Depth;
+};
+
+float Milliseconds(uint64_t nanoseconds) {
+    return static_cast<float>(nanoseconds / 1.0e6);
+}
+
+ImU32 ScopeColor(const char* name) {
+    // Stable per name: interned/literal names keep their address
+    float hue = static_cast<float>(std::hash<const void*>{}(name) % 360) / 360.0f;
+    return ImColor::HSV(hue, 0.45f, 0.65f);
+}
+
+// Nesting depth of each scope, from begin/end times alone
+std::vector<ScopeBar> LayoutScopes(const std::vector<ProfileEvent>& events, uint32_t& maxDepth) {
+    std::vector<ScopeBar> bars;
+    bars.reserve(events.size());
+    for (const ProfileEvent& event : events)
+        bars.push_back({&event, 0});
+    std::sort(bars.begin(), bars.end(), [](const ScopeBar& a, const ScopeBar& b) {
+        if (a.Event->Start != b.Event->Start)
+            return a.Event->Start < b.Event->Start;
+        return a.Event->End > b.Event->End;
+    });
+
+    std::vector<uint64_t> open;
+    maxDepth = 0;
+    for (ScopeBar& bar : bars) {
+        while (!open.empty() && open.back() <= bar.Event->Start)
+            open.pop_back();
+        bar.Depth = static_cast<uint32_t>(open.size());
+        maxDepth = std::max(maxDepth, bar.Depth);
+        open.push_back(bar.Event->End);
+    }
+    return bars;
+}
+
+} // namespace
+
+PerformancePanel::PerformancePanel() : history_(kHistorySize) {}
+
+void PerformancePanel::AddFrame(const FrameRecord& record) {
+    if (paused_)
+        return;
+
+    history_[head_] = record;
+    head_ = (head_ + 1) % kHistorySize;
+    count_ = std::min(count_ + 1, kHistorySize);
+}
+
+const FrameRecord& PerformancePanel::GetFrame(uint32_t age) const {
+    return history_[(head_ + kHistorySize - 1 - age) % kHistorySize];
+}
+
+FrameRecord PerformancePanel::Average(uint32_t frames) const {
+    FrameRecord average;
+    frames = std::min(frames, count_);
+    if (frames == 0)
+        return average;
+
+    average = GetFrame(0);
+    for (uint32_t age = 1; age < frames; ++age) {
+        const FrameRecord& frame = GetFrame(age);
+        average.FrameMs += frame.FrameMs;
+        for (size_t i = 0; i < kFramePhaseCount; ++i)
+            average.PhaseMs[i] += frame.PhaseMs[i];
+        // Layers by position; the newest frame provides the names
+        for (uint32_t i = 0; i < average.LayerCount; ++i) {
+            average.Layers[i].UpdateMs += frame.Layers[i].UpdateMs;
+            average.Layers[i].RenderMs += frame.Layers[i].RenderMs;
+            average.Layers[i].ImGuiMs += frame.Layers[i].ImGuiMs;
+        }
+        average.Render.ShadowPassMs += frame.Render.ShadowPassMs;
+        average.Render.ScenePassMs += frame.Render.ScenePassMs;
+        for (size_t i = 0; i < kGpuPassCount; ++i)
+            average.Render.GpuPasses[i].Milliseconds += frame.Render.GpuPasses[i].Milliseconds;
+    }
+
+    float scale = 1.0f / frames;
+    average.FrameMs *= scale;
+    for (float& phase : average.PhaseMs)
+        phase *= scale;
+    for (uint32_t i = 0; i < average.LayerCount; ++i) {
+        average.Layers[i].UpdateMs *= scale;
+        average.Layers[i].RenderMs *= scale;
+        average.Layers[i].ImGuiMs *= scale;
+    }
+    average.Render.ShadowPassMs *= scale;
+    average.Render.ScenePassMs *= scale;
+    for (GpuPassStats& pass : average.Render.GpuPasses)
+        pass.Milliseconds *= scale;
+    return average;
+}
+
+void PerformancePanel::SelectFrame(uint32_t age) {
+    if (age >= count_)
+        return;
+
+    paused_ = true;
+    selectedAge_ = static_cast<int32_t>(age);
+    const FrameRecord& frame = GetFrame(age);
+    selectedScopes_ = Profiler::Capture(frame.StartNs, frame.EndNs);
+}
+
+void PerformancePanel::ClearSelection() {
+    selectedAge_ = -1;
+    selectedScopes_.clear();
+}
+
+void PerformancePanel::OnImGuiRender() {
+    if (!open_)
+        return;
+
+    ImGui::SetNextWindowSize(ImVec2(520, 640), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Performance", &open_)) {
+        ImGui::End();
+        return;
+    }
+
+    if (ImGui::Checkbox("Pause", &paused_) && !paused_)
+        ClearSelection();
+    ImGui::SameLine();
+    ImGui::TextDisabled("(click a frame to inspect it)");
+
+    DrawFrameGraph();
+    DrawPercentiles();
+
+    if (count_ == 0) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Separator();
+    if (selectedAge_ >= 0) {
+        const FrameRecord& frame = GetFrame(static_cast<uint32_t>(selectedAge_));
+        if (ImGui::ArrowButton("##older", ImGuiDir_Left))
+            SelectFrame(static_cast<uint32_t>(selectedAge_) + 1);
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("##newer", ImGuiDir_Right) && selectedAge_ > 0)
+            SelectFrame(static_cast<uint32_t>(selectedAge_) - 1);
+        ImGui::SameLine();
+        ImGui::Text("Frame %llu: %.3f ms", static_cast<unsigned long long>(frame.Index),
+                    frame.FrameMs);
+
+        DrawBreakdown(frame);
+        DrawScopes(frame);
+    } else {
+        ImGui::Text("Average of the last %u frame(s)", std::min(kAverageFrames, count_));
+        DrawBreakdown(Average(kAverageFrames));
+    }
+
+    ImGui::End();
+}
+
+void PerformancePanel::DrawFrameGraph() {
+    if (count_ == 0)
+        return;
+
+    auto getter = [](void* data, int index) -> float {
+        auto* panel = static_cast<PerformancePanel*>(data);
+        return panel->GetFrame(panel->count_ - 1 - static_cast<uint32_t>(index)).FrameMs;
+    };
+
+    float maxMs = 0.0f;
+    for (uint32_t age = 0; age < count_; ++age)
+        maxMs = std::max(maxMs, GetFrame(age).FrameMs);
+
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "%.2f ms (max %.2f)", GetFrame(0).FrameMs, maxMs);
+    ImGui::PlotHistogram("##frames", getter, this, static_cast<int>(count_), 0, overlay, 0.0f,
+                         std::max(maxMs, 1.0f), ImVec2(ImGui::GetContentRegionAvail().x, 90));
+
+    if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0)) {
+        ImVec2 min = ImGui::GetItemRectMin();
+        ImVec2 size = ImGui::GetItemRectSize();
+        float t = (ImGui::GetIO().MousePos.x - min.x) / std::max(size.x, 1.0f);
+        auto index = static_cast<uint32_t>(std::clamp(t, 0.0f, 0.999f) * count_);
+        SelectFrame(count_ - 1 - index);
+    }
+}
+
+void PerformancePanel::DrawPercentiles() {
+    if (count_ == 0)
+        return;
+
+    for (uint32_t age = 0; age < count_; ++age)
+        sortScratch_[age] = GetFrame(age).FrameMs;
+
+    float* values = sortScratch_.data();
+    float p50 = Percentile(values, count_, 0.50f);
+    float p95 = Percentile(values, count_, 0.95f);
+    float p99 = Percentile(values, count_, 0.99f);
+
+    // Stutter: frames far above the typical one
+    uint32_t hitches = 0;
+    for (uint32_t age = 0; age < count_; ++age) {
+        if (GetFrame(age).FrameMs > 2.0f * p50)
+            hitches++;
+    }
+
+    ImGui::Text("p50 %.2f ms | p95 %.2f ms | p99 %.2f ms  (%u frames)", p50, p95, p99,
+                count_);
+    ImGui::Text("Hitches (> 2x p50): %u", hitches);
+}
+
+void PerformancePanel::DrawBreakdown(const FrameRecord& frame) {
+    float frameMs = std::max(frame.FrameMs, 0.001f);
+    char label[64];
+
+    if (ImGui::TreeNodeEx("CPU phases", ImGuiTreeNodeFlags_DefaultOpen)) {
+        for (size_t i = 0; i < kFramePhaseCount; ++i) {
+            float ms = frame.PhaseMs[i];
+            snprintf(label, sizeof(label), "%.3f ms", ms);
+            ImGui::ProgressBar(ms / frameMs, ImVec2(180, 0), label);
+            ImGui::SameLine();
+            ImGui::TextUnformatted(GetFramePhaseName(static_cast<FramePhase>(i)));
+        }
+        ImGui::TreePop();
+    }
+
+    if (frame.LayerCount > 0 && ImGui::TreeNodeEx("Layers", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Columns(4, "layers");
+        ImGui::Text("Layer");
+        ImGui::NextColumn();
+        ImGui::Text("Update");
+        ImGui::NextColumn();
+        ImGui::Text("Render");
+        ImGui::NextColumn();
+        ImGui::Text("ImGui");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        for (uint32_t i = 0; i < frame.LayerCount; ++i) {
+            const LayerTiming& layer = frame.Layers[i];
+            ImGui::TextUnformatted(layer.Name ? layer.Name : "?");
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", layer.UpdateMs);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", layer.RenderMs);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", layer.ImGuiMs);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNodeEx("Render passes", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const float cpuMs[kGpuPassCount] = {frame.Render.ShadowPassMs, frame.Render.ScenePassMs,
+                                            frame.GetPhase(FramePhase::ImGui)};
+        ImGui::Columns(3, "passes");
+        ImGui::Text("Pass");
+        ImGui::NextColumn();
+        ImGui::Text("CPU ms");
+        ImGui::NextColumn();
+        ImGui::Text("GPU ms");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        for (size_t i = 0; i < kGpuPassCount; ++i) {
+            const GpuPassStats& gpu = frame.Render.GpuPasses[i];
+            ImGui::TextUnformatted(GpuProfiler::GetPassName(static_cast<GpuPass>(i)));
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", cpuMs[i]);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", gpu.Milliseconds);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+        ImGui::TextDisabled("GPU times lag %u frames; ImGui CPU includes UI building",
+                            GpuProfiler::kFrameLatency);
+        ImGui::Text("Draw calls %u | triangles %u", frame.Render.DrawCalls,
+                    frame.Render.TriangleCount);
+        ImGui::TreePop();
+    }
+
+    // Counts are exact per frame, so the live view shows the newest frame rather than an
+    // average
+    const FrameCounters& counters = frame.Render.Counters;
+    if (ImGui::TreeNodeEx("Submission counters", ImGuiTreeNodeFlags_DefaultOpen)) {
+        PassCounters total = counters.Total();
+        const PassCounters* columns[kCounterPassCount + 1];
+        for (size_t i = 0; i < kCounterPassCount; ++i)
+            columns[i] = &counters.Passes[i];
+        columns[kCounterPassCount] = &total;
+
+        ImGui::Columns(kCounterPassCount + 2, "counters");
+        ImGui::NextColumn();
+        for (size_t i = 0; i < kCounterPassCount; ++i) {
+            ImGui::TextUnformatted(RenderCounters::GetPassName(i));
+            ImGui::NextColumn();
+        }
+        ImGui::Text("Total");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        auto row = [&](const char* name, auto field) {
+            ImGui::TextUnformatted(name);
+            ImGui::NextColumn();
+            for (const PassCounters* pass : columns) {
+                ImGui::Text("%llu", static_cast<unsigned long long>(pass->*field));
+                ImGui::NextColumn();
+            }
+        };
+        row("Draws", &PassCounters::DrawCalls);
+        row("Triangles", &PassCounters::Triangles);
+        row("Programs", &PassCounters::ProgramBinds);
+        row("VAOs", &PassCounters::VertexArrayBinds);
+        row("Textures", &PassCounters::TextureBinds);
+        row("Framebuffers", &PassCounters::FramebufferBinds);
+        row("Uniforms", &PassCounters::UniformUploads);
+        row("Uniform bytes", &PassCounters::UniformBytes);
+        row("Buffer uploads", &PassCounters::BufferUploads);
+        row("Buffer bytes", &PassCounters::BufferBytes);
+        ImGui::Columns(1);
+
+        ImGui::Text("Objects submitted %u | culled %u", counters.ObjectsSubmitted,
+                    counters.ObjectsCulled);
+        ImGui::TreePop();
+    }
+
+    if (HardwareCounters::IsEnabled() &&
+        ImGui::TreeNodeEx("Hardware counters", ImGuiTreeNodeFlags_DefaultOpen)) {
+        const HardwareFrameStats& hardware = frame.Hardware;
+        ImGui::Columns(7, "hardware");
+        const char* headers[] = {"", "Cycles", "Instr.", "IPC", "L1D miss", "LLC miss",
+                                 "Br. miss"};
+        for (const char* header : headers) {
+            ImGui::TextUnformatted(header);
+            ImGui::NextColumn();
+        }
+        ImGui::Separator();
+
+        auto row = [](const char* name, const CounterValues& values) {
+            ImGui::TextUnformatted(name);
+            ImGui::NextColumn();
+            for (HardwareCounter counter :
+                 {HardwareCounter::Cycles, HardwareCounter::Instructions}) {
+                ImGui::Text("%llu", static_cast<unsigned long long>(values.Get(counter)));
+                ImGui::NextColumn();
+            }
+            ImGui::Text("%.2f", values.InstructionsPerCycle());
+            ImGui::NextColumn();
+            for (HardwareCounter counter : {HardwareCounter::L1DMisses, HardwareCounter::LLCMisses,
+                                            HardwareCounter::BranchMisses}) {
+                ImGui::Text("%llu", static_cast<unsigned long long>(values.Get(counter)));
+                ImGui::NextColumn();
+            }
+        };
+        row("Main thread", hardware.MainThread);
+        row("Workers", hardware.Workers);
+        for (uint32_t i = 0; i < hardware.ScopeCount; ++i)
+            row(hardware.Scopes[i].Name, hardware.Scopes[i].Values);
+        ImGui::Columns(1);
+
+        if (!HardwareCounters::IsAvailable(HardwareCounter::Cycles))
+            ImGui::TextDisabled("No PMU access here (VM?); only software counters are live");
+        ImGui::TreePop();
+    }
+
+    if (ImGui::TreeNodeEx("Allocations", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (!AllocationTracker::IsCompiledIn()) {
+            ImGui::TextDisabled("Allocation tracking needs a build with SE_TRACK_ALLOCATIONS");
+            ImGui::TreePop();
+            return;
+        }
+
+        const AllocationFrameStats& allocations = frame.Allocations;
+        AllocationCounters total = allocations.Total();
+        ImGui::Text("%llu allocation(s), %.1f KiB | %llu free(s)",
+                    static_cast<unsigned long long>(total.Count), total.Bytes / 1024.0,
+                    static_cast<unsigned long long>(allocations.Frees));
+        for (size_t i = 0; i < kAllocTagCount; ++i) {
+            const AllocationCounters& tag = allocations.Tags[i];
+            if (tag.Count == 0)
+                continue;
+            ImGui::BulletText("%s: %llu (%.1f KiB)",
+                              AllocationTracker::GetTagName(static_cast<AllocTag>(i)),
+                              static_cast<unsigned long long>(tag.Count), tag.Bytes / 1024.0);
+        }
+        if (allocations.ZeroAllocViolations > 0) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "%llu in zero-alloc scopes",
+                               static_cast<unsigned long long>(allocations.ZeroAllocViolations));
+        }
+        ImGui::TreePop();
+    }
+}
+
+void PerformancePanel::DrawScopes(const FrameRecord& frame) {
+    if (!ImGui::TreeNodeEx("Scopes", ImGuiTreeNodeFlags_DefaultOpen))
+        return;
+
+#ifndef SE_PROFILE
+    ImGui::TextDisabled("Scope capture needs a build with SE_PROFILE");
+    ImGui::TreePop();
+    return;
+#endif
+
+    bool anyScopes = false;
+    uint64_t frameNs = std::max<uint64_t>(frame.EndNs - frame.StartNs, 1);
+    float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+
+    for (const ProfileThreadCapture& thread : selectedScopes_) {
+        if (thread.Events.empty())
+            continue;
+        anyScopes = true;
+
+        uint32_t maxDepth = 0;
+        std::vector<ScopeBar> bars = LayoutScopes(thread.Events, maxDepth);
+
+        ImGui::TextUnformatted(thread.Name.c_str());
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size(ImGui::GetContentRegionAvail().x, rowHeight * (maxDepth + 1));
+        ImGui::InvisibleButton(thread.Name.c_str(), ImVec2(std::max(size.x, 1.0f), size.y));
+        bool hovered = ImGui::IsItemHovered();
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+        for (const ScopeBar& bar : bars) {
+            // Clamp scopes that straddle the frame boundaries
+            uint64_t start = std::clamp(bar.Event->Start, frame.StartNs, frame.EndNs);
+            uint64_t end = std::clamp(bar.Event->End, frame.StartNs, frame.EndNs);
+            float x0 = origin.x + size.x * (start - frame.StartNs) / frameNs;
+            float x1 = std::max(origin.x + size.x * (end - frame.StartNs) / frameNs, x0 + 1.0f);
+            float y0 = origin.y + rowHeight * bar.Depth;
+            ImVec2 min(x0, y0);
+            ImVec2 max(x1, y0 + rowHeight - 1.0f);
+
+            drawList->AddRectFilled(min, max, ScopeColor(bar.Event->Name));
+            if (x1 - x0 > 24.0f) {
+                drawList->PushClipRect(min, max, true);
+                drawList->AddText(ImVec2(x0 + 2.0f, y0), IM_COL32_WHITE, bar.Event->Name);
+                drawList->PopClipRect();
+            }
+
+            if (hovered && ImGui::IsMouseHoveringRect(min, max)) {
+                ImGui::SetTooltip("%s\n%.3f ms", bar.Event->Name,
+                                  Milliseconds(bar.Event->End - bar.Event->Start));
+            }
+        }
+        drawList->PopClipRect();
+    }
+
+    if (!anyScopes) {
+        ImGui::TextDisabled("No scopes buffered for this frame (too old, or profiling off)");
+    } else if (ImGui::TreeNode("Totals")) {
+        // Inclusive time per scope name over every thread
+        std::unordered_map<const char*, std::pair<float, uint32_t>> totals;
+        for (const ProfileThreadCapture& thread : selectedScopes_) {
+            for (const ProfileEvent& event : thread.Events) {
+                auto& total = totals[event.Name];
+                total.first += Milliseconds(event.End - event.Start);
+                total.second++;
+            }
+        }
+        std::vector<std::pair<const char*, std::pair<float, uint32_t>>> sorted(totals.begin(),
+                                                                              totals.end());
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+            return a.second.first > b.second.first;
+        });
+        for (const auto& [name, total] : sorted)
+            ImGui::Text("%8.3f ms  x%-4u %s", total.first, total.second, name);
+        ImGui::TreePop();
+    }
+
+    ImGui::TreePop();
+}
+
+} // namespace se
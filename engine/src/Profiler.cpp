@@ -0,0 +1,204 @@
+#include "engine/Profiler.h"
+#include "engine/Log.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace se {
+
+namespace {
+
+// Written only by its thread. The owner stores the event, then publishes it by bumping
+// Head; readers copy and afterwards drop whatever the writer may have lapped meanwhile.
+struct ThreadBuffer {
+    std::array<ProfileEvent, Profiler::kEventsPerThread> Events;
+    std::atomic<uint64_t> Head{0};
+    uint32_t ThreadId = 0;
+    std::string Name;
+};
+
+struct ProfilerState {
+    const Profiler::Clock::time_point Epoch = Profiler::Clock::now();
+    std::atomic<bool> Enabled{true};
+
+    std::mutex Mutex;
+    // Buffers outlive their threads so a trace still shows jobs from finished workers
+    std::vector<std::unique_ptr<ThreadBuffer>> Buffers;
+    std::unordered_set<std::string> Names;
+};
+
+ProfilerState& State() {
+    static ProfilerState state;
+    return state;
+}
+
+thread_local ThreadBuffer* tls_Buffer = nullptr;
+
+ThreadBuffer& CurrentBuffer() {
+    if (!tls_Buffer) {
+        ProfilerState& state = State();
+        std::lock_guard<std::mutex> lock(state.Mutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->ThreadId = static_cast<uint32_t>(state.Buffers.size() + 1);
+        buffer->Name = "Thread " + std::to_string(buffer->ThreadId);
+        tls_Buffer = buffer.get();
+        state.Buffers.push_back(std::move(buffer));
+    }
+    return *tls_Buffer;
+}
+
+void WriteJsonString(std::FILE* file, const char* text) {
+    std::fputc('"', file);
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\')
+            std::fputc('\\', file);
+        if (static_cast<unsigned char>(*c) >= 0x20)
+            std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+
+} // namespace
+
+void Profiler::SetEnabled(bool enabled) {
+    State().Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled() {
+    return State().Enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(std::string_view name) {
+#ifdef SE_PROFILE
+    ThreadBuffer& buffer = CurrentBuffer();
+    std::lock_guard<std::mutex> lock(State().Mutex);
+    buffer.Name = name;
+#else
+    (void)name;
+#endif
+}
+
+const char* Profiler::InternName(std::string_view name) {
+    ProfilerState& state = State();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    // Node-based set: element addresses never change
+    return state.Names.emplace(name).first->c_str();
+}
+
+uint64_t Profiler::Now() noexcept {
+    auto elapsed = Clock::now() - State().Epoch;
+    return static_cast<uint64_t>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) +
+           1;
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end) noexcept {
+    ThreadBuffer& buffer = CurrentBuffer();
+    uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+    buffer.Events[head % kEventsPerThread] = {name, start, end};
+    buffer.Head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<ProfileThreadCapture> Profiler::Capture(uint64_t begin, uint64_t end) {
+    std::vector<ProfileThreadCapture> threads;
+#ifdef SE_PROFILE
+    ProfilerState& state = State();
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    threads.reserve(state.Buffers.size());
+    for (const auto& buffer : state.Buffers) {
+        uint64_t head = buffer->Head.load(std::memory_order_acquire);
+        uint64_t first = head > kEventsPerThread ? head - kEventsPerThread : 0;
+
+        std::vector<ProfileEvent> events;
+        events.reserve(head - first);
+        for (uint64_t i = first; i < head; ++i)
+            events.push_back(buffer->Events[i % kEventsPerThread]);
+
+        // Slots the writer reused while we were copying may be torn; skip them
+        uint64_t newHead = buffer->Head.load(std::memory_order_acquire);
+        uint64_t valid = newHead > kEventsPerThread ? newHead - kEventsPerThread : 0;
+        size_t lapped = valid > first ? static_cast<size_t>(std::min(valid, head) - first) : 0;
+
+        ProfileThreadCapture capture{buffer->ThreadId, buffer->Name, {}};
+        for (size_t i = lapped; i < events.size(); ++i) {
+            if (events[i].Start < end && events[i].End > begin)
+                capture.Events.push_back(events[i]);
+        }
+        threads.push_back(std::move(capture));
+    }
+#else
+    (void)begin;
+    (void)end;
+#endif
+    return threads;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) {
+#ifndef SE_PROFILE
+    SE_LOG_WARN("Profiler: built without SE_PROFILE, no trace written to '{}'", path);
+    return false;
+#else
+    return WriteChromeTrace(path, Capture(), {}, {});
+#endif
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path,
+                                const std::vector<ProfileThreadCapture>& threads,
+                                std::string_view extraEvents, std::string_view extraFields) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        SE_LOG_ERROR("Profiler: cannot open '{}' for writing", path);
+        return false;
+    }
+
+    size_t eventCount = 0;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const ProfileThreadCapture& thread : threads) {
+        std::fprintf(file,
+                     "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"name\":",
+                     first ? "" : ",\n", thread.ThreadId);
+        WriteJsonString(file, thread.Name.c_str());
+        std::fputs("}}", file);
+        first = false;
+
+        for (const ProfileEvent& event : thread.Events) {
+            // Microseconds, as the format expects
+            std::fputs(",\n{\"name\":", file);
+            WriteJsonString(file, event.Name);
+            std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         thread.ThreadId, event.Start / 1000.0,
+                         (event.End - event.Start) / 1000.0);
+        }
+        eventCount += thread.Events.size();
+    }
+    if (!extraEvents.empty()) {
+        std::fputs(first ? "" : ",\n", file);
+        std::fwrite(extraEvents.data(), 1, extraEvents.size(), file);
+    }
+    std::fputs("\n]", file);
+    if (!extraFields.empty()) {
+        std::fputs(",\n", file);
+        std::fwrite(extraFields.data(), 1, extraFields.size(), file);
+    }
+    std::fputs("}\n", file);
+
+    bool ok = std::ferror(file) == 0;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        SE_LOG_ERROR("Profiler: failed writing '{}'", path);
+        return false;
+    }
+
+    SE_LOG_INFO("Profiler: wrote {} scope(s) from {} thread(s) to '{}'", eventCount,
+                threads.size(), path);
+    return true;
+}
+
+} // namespace se
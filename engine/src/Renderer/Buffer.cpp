@@ -1,6 +1,8 @@
 #include "engine/renderer/Buffer.h"
+#include "engine/renderer/RenderCounters.h"
 #include <glad/glad.h>
 #include <stdexcept>
+#include <utility>
 
 namespace se {
 
@@ -74,6 +76,10 @@ BufferLayout::BufferLayout(const std::initializer_list<BufferElement>& elements)
     CalculateOffsetsAndStride();
 }
 
+BufferLayout::BufferLayout(std::vector<BufferElement> elements) : elements_(std::move(elements)) {
+    CalculateOffsetsAndStride();
+}
+
 void BufferLayout::CalculateOffsetsAndStride() {
     uint32_t offset = 0;
     stride_ = 0;
@@ -90,6 +96,7 @@ VertexBuffer::VertexBuffer(const void* vertices, uint32_t size) {
     glGenBuffers(1, &rendererId_);
     glBindBuffer(GL_ARRAY_BUFFER, rendererId_);
     glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+    RenderCounters::AddBufferUpload(size);
 }
 
 VertexBuffer::VertexBuffer(uint32_t size) {
@@ -114,15 +121,19 @@ void VertexBuffer::Unbind() const {
 void VertexBuffer::SetData(const void* data, uint32_t size) {
     glBindBuffer(GL_ARRAY_BUFFER, rendererId_);
     glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    RenderCounters::AddBufferUpload(size);
 }
 
 // ========== IndexBuffer ==========
 
 IndexBuffer::IndexBuffer(const uint32_t* indices, uint32_t count) : count_(count) {
     glGenBuffers(1, &rendererId_);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererId_);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    // Upload through GL_ARRAY_BUFFER: the element array binding is vertex array state, so
+    // binding it here would clobber whichever vertex array is currently bound
+    glBindBuffer(GL_ARRAY_BUFFER, rendererId_);
+    glBufferData(GL_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    RenderCounters::AddBufferUpload(count * sizeof(uint32_t));
 }
 
 IndexBuffer::~IndexBuffer() {
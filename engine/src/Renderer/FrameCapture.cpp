@@ -0,0 +1,317 @@
+#include "engine/renderer/FrameCapture.h"
+#include "engine/Log.h"
+#include "engine/renderer/VertexArray.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <glad/glad.h>
+#include <type_traits>
+
+namespace se {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x43464553; // "SEFC" on little-endian machines
+constexpr uint32_t kVersion = 1;
+
+constexpr uint8_t kCastsShadows = 1 << 0;
+constexpr uint8_t kReceiveShadows = 1 << 1;
+
+class Writer {
+  public:
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<uint32_t>(value.size()));
+        WriteBytes(value.data(), value.size());
+    }
+
+    template <typename T>
+    void WriteUniforms(const std::vector<std::pair<std::string, T>>& uniforms) {
+        Write(static_cast<uint32_t>(uniforms.size()));
+        for (const auto& [name, value] : uniforms) {
+            WriteString(name);
+            Write(value);
+        }
+    }
+
+    const std::vector<uint8_t>& GetBuffer() const {
+        return buffer_;
+    }
+
+  private:
+    std::vector<uint8_t> buffer_;
+};
+
+// Every read is bounds-checked; the first short read turns the reader invalid and all
+// later reads return zeroes
+class Reader {
+  public:
+    explicit Reader(const std::vector<uint8_t>& data) : data_(data) {}
+
+    template <typename T>
+    T Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        ReadBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void ReadBytes(void* out, size_t size) {
+        if (!valid_ || size > data_.size() - offset_) {
+            valid_ = false;
+            return;
+        }
+        std::memcpy(out, data_.data() + offset_, size);
+        offset_ += size;
+    }
+
+    // Element count of an upcoming array; rejects counts the remaining bytes can't hold
+    uint32_t ReadCount(size_t minElementSize) {
+        uint32_t count = Read<uint32_t>();
+        if (minElementSize > 0 && count > (data_.size() - offset_) / minElementSize)
+            valid_ = false;
+        return valid_ ? count : 0;
+    }
+
+    std::string ReadString() {
+        std::string value(ReadCount(1), '\0');
+        ReadBytes(value.data(), value.size());
+        return value;
+    }
+
+    template <typename T>
+    void ReadUniforms(std::vector<std::pair<std::string, T>>& uniforms) {
+        uint32_t count = ReadCount(sizeof(uint32_t) + sizeof(T));
+        uniforms.reserve(count);
+        for (uint32_t i = 0; i < count && valid_; ++i) {
+            std::string name = ReadString();
+            uniforms.emplace_back(std::move(name), Read<T>());
+        }
+    }
+
+    // Structurally complete but inconsistent (e.g. an index out of range)
+    void Invalidate() {
+        valid_ = false;
+    }
+
+    bool IsValid() const {
+        return valid_;
+    }
+    bool IsAtEnd() const {
+        return offset_ == data_.size();
+    }
+
+  private:
+    const std::vector<uint8_t>& data_;
+    size_t offset_ = 0;
+    bool valid_ = true;
+};
+
+std::vector<uint8_t> ReadBuffer(uint32_t buffer) {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    GLint size = 0;
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+    std::vector<uint8_t> data(static_cast<size_t>(size > 0 ? size : 0));
+    if (!data.empty())
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, data.data());
+    return data;
+}
+
+} // namespace
+
+bool FrameCapture::Save(const CapturedFrame& frame, const std::filesystem::path& path) {
+    Writer writer;
+    writer.Write(kMagic);
+    writer.Write(kVersion);
+
+    writer.Write(frame.ViewMatrix);
+    writer.Write(frame.ProjectionMatrix);
+    const SceneRenderer::DirectionalLightData& light = frame.DirectionalLight;
+    writer.Write(light.Direction);
+    writer.Write(light.Color);
+    writer.Write(light.Intensity);
+    writer.Write(light.Position);
+    writer.Write(static_cast<uint8_t>(light.CastShadows));
+    writer.Write(static_cast<uint8_t>(light.Active));
+    writer.Write(frame.ViewportSize);
+
+    writer.Write(static_cast<uint32_t>(frame.Shaders.size()));
+    for (const CapturedShader& shader : frame.Shaders) {
+        writer.WriteString(shader.VertexSource);
+        writer.WriteString(shader.FragmentSource);
+    }
+
+    writer.Write(static_cast<uint32_t>(frame.Materials.size()));
+    for (const CapturedMaterial& material : frame.Materials) {
+        writer.Write(material.Shader);
+        writer.WriteUniforms(material.Floats);
+        writer.WriteUniforms(material.Ints);
+        writer.WriteUniforms(material.Vector3s);
+        writer.WriteUniforms(material.Vector4s);
+        writer.WriteUniforms(material.Matrix4s);
+    }
+
+    writer.Write(static_cast<uint32_t>(frame.Meshes.size()));
+    for (const CapturedMesh& mesh : frame.Meshes) {
+        writer.Write(static_cast<uint32_t>(mesh.VertexBuffers.size()));
+        for (const CapturedVertexBuffer& buffer : mesh.VertexBuffers) {
+            writer.Write(static_cast<uint32_t>(buffer.Layout.size()));
+            for (const BufferElement& element : buffer.Layout) {
+                writer.WriteString(element.Name);
+                writer.Write(static_cast<uint32_t>(element.Type));
+                writer.Write(static_cast<uint8_t>(element.Normalized));
+            }
+            writer.Write(static_cast<uint32_t>(buffer.Data.size()));
+            writer.WriteBytes(buffer.Data.data(), buffer.Data.size());
+        }
+        writer.Write(static_cast<uint32_t>(mesh.Indices.size()));
+        writer.WriteBytes(mesh.Indices.data(), mesh.Indices.size() * sizeof(uint32_t));
+    }
+
+    writer.Write(static_cast<uint32_t>(frame.Submissions.size()));
+    for (const CapturedSubmission& submission : frame.Submissions) {
+        writer.Write(submission.Mesh);
+        writer.Write(submission.Material);
+        writer.Write(submission.Transform);
+        uint8_t flags = (submission.CastsShadows ? kCastsShadows : 0) |
+                        (submission.ReceiveShadows ? kReceiveShadows : 0);
+        writer.Write(flags);
+    }
+
+    std::error_code error;
+    if (path.has_parent_path())
+        std::filesystem::create_directories(path.parent_path(), error);
+
+    const std::vector<uint8_t>& bytes = writer.GetBuffer();
+    std::FILE* file = std::fopen(path.string().c_str(), "wb");
+    bool written = file && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if (file)
+        written = std::fclose(file) == 0 && written;
+    if (!written)
+        SE_LOG_ERROR("Failed to write frame capture '{}'", path.string());
+    return written;
+}
+
+std::optional<CapturedFrame> FrameCapture::Load(const std::filesystem::path& path) {
+    std::vector<uint8_t> bytes;
+    if (std::FILE* file = std::fopen(path.string().c_str(), "rb")) {
+        uint8_t chunk[64 * 1024];
+        size_t read = 0;
+        while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            bytes.insert(bytes.end(), chunk, chunk + read);
+        std::fclose(file);
+    } else {
+        SE_LOG_ERROR("Failed to open frame capture '{}'", path.string());
+        return std::nullopt;
+    }
+
+    Reader reader(bytes);
+    if (reader.Read<uint32_t>() != kMagic) {
+        SE_LOG_ERROR("'{}' is not a frame capture", path.string());
+        return std::nullopt;
+    }
+    uint32_t version = reader.Read<uint32_t>();
+    if (version != kVersion) {
+        SE_LOG_ERROR("Frame capture '{}' has version {}, expected {}", path.string(), version,
+                     kVersion);
+        return std::nullopt;
+    }
+
+    CapturedFrame frame;
+    frame.ViewMatrix = reader.Read<glm::mat4>();
+    frame.ProjectionMatrix = reader.Read<glm::mat4>();
+    SceneRenderer::DirectionalLightData& light = frame.DirectionalLight;
+    light.Direction = reader.Read<glm::vec3>();
+    light.Color = reader.Read<glm::vec3>();
+    light.Intensity = reader.Read<float>();
+    light.Position = reader.Read<glm::vec3>();
+    light.CastShadows = reader.Read<uint8_t>() != 0;
+    light.Active = reader.Read<uint8_t>() != 0;
+    frame.ViewportSize = reader.Read<glm::ivec2>();
+
+    frame.Shaders.resize(reader.ReadCount(2 * sizeof(uint32_t)));
+    for (CapturedShader& shader : frame.Shaders) {
+        shader.VertexSource = reader.ReadString();
+        shader.FragmentSource = reader.ReadString();
+    }
+
+    frame.Materials.resize(reader.ReadCount(6 * sizeof(uint32_t)));
+    for (CapturedMaterial& material : frame.Materials) {
+        material.Shader = reader.Read<uint32_t>();
+        reader.ReadUniforms(material.Floats);
+        reader.ReadUniforms(material.Ints);
+        reader.ReadUniforms(material.Vector3s);
+        reader.ReadUniforms(material.Vector4s);
+        reader.ReadUniforms(material.Matrix4s);
+        if (material.Shader >= frame.Shaders.size())
+            reader.Invalidate();
+    }
+
+    frame.Meshes.resize(reader.ReadCount(2 * sizeof(uint32_t)));
+    for (CapturedMesh& mesh : frame.Meshes) {
+        mesh.VertexBuffers.resize(reader.ReadCount(2 * sizeof(uint32_t)));
+        for (CapturedVertexBuffer& buffer : mesh.VertexBuffers) {
+            uint32_t elementCount = reader.ReadCount(2 * sizeof(uint32_t) + 1);
+            for (uint32_t i = 0; i < elementCount && reader.IsValid(); ++i) {
+                std::string name = reader.ReadString();
+                auto type = static_cast<ShaderDataType>(reader.Read<uint32_t>());
+                bool normalized = reader.Read<uint8_t>() != 0;
+                buffer.Layout.emplace_back(type, name, normalized);
+            }
+            buffer.Data.resize(reader.ReadCount(1));
+            reader.ReadBytes(buffer.Data.data(), buffer.Data.size());
+        }
+        mesh.Indices.resize(reader.ReadCount(sizeof(uint32_t)));
+        reader.ReadBytes(mesh.Indices.data(), mesh.Indices.size() * sizeof(uint32_t));
+    }
+
+    frame.Submissions.resize(reader.ReadCount(2 * sizeof(uint32_t) + sizeof(glm::mat4) + 1));
+    for (CapturedSubmission& submission : frame.Submissions) {
+        submission.Mesh = reader.Read<uint32_t>();
+        submission.Material = reader.Read<uint32_t>();
+        submission.Transform = reader.Read<glm::mat4>();
+        uint8_t flags = reader.Read<uint8_t>();
+        submission.CastsShadows = (flags & kCastsShadows) != 0;
+        submission.ReceiveShadows = (flags & kReceiveShadows) != 0;
+        bool hasMaterial = submission.Material != CapturedSubmission::kNoMaterial;
+        if (submission.Mesh >= frame.Meshes.size() ||
+            (hasMaterial && submission.Material >= frame.Materials.size()))
+            reader.Invalidate();
+    }
+
+    if (!reader.IsValid() || !reader.IsAtEnd()) {
+        SE_LOG_ERROR("Frame capture '{}' is truncated or corrupt", path.string());
+        return std::nullopt;
+    }
+    return frame;
+}
+
+CapturedMesh FrameCapture::ReadBack(const VertexArray& vertexArray) {
+    CapturedMesh mesh;
+    // GL_COPY_READ_BUFFER leaves the array and element bindings of the bound VAO alone
+    for (const auto& vertexBuffer : vertexArray.GetVertexBuffers()) {
+        CapturedVertexBuffer& buffer = mesh.VertexBuffers.emplace_back();
+        buffer.Layout = vertexBuffer->GetLayout().GetElements();
+        buffer.Data = ReadBuffer(vertexBuffer->GetRendererID());
+    }
+    if (const auto& indexBuffer = vertexArray.GetIndexBuffer()) {
+        std::vector<uint8_t> indices = ReadBuffer(indexBuffer->GetRendererID());
+        mesh.Indices.resize(std::min<size_t>(indexBuffer->GetCount(),
+                                             indices.size() / sizeof(uint32_t)));
+        std::memcpy(mesh.Indices.data(), indices.data(), mesh.Indices.size() * sizeof(uint32_t));
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    return mesh;
+}
+
+} // namespace se
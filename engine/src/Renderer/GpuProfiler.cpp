@@ -0,0 +1,255 @@
+#include "engine/renderer/GpuProfiler.h"
+#include "engine/Log.h"
+#include "engine/renderer/RenderCommand.h"
+#include "engine/renderer/RenderCounters.h"
+#include <atomic>
+#include <cstring>
+#include <glad/glad.h>
+#include <mutex>
+
+namespace se {
+
+namespace {
+
+constexpr uint32_t kStatCount = 3;
+constexpr GLenum kStatTargets[kStatCount] = {GL_VERTICES_SUBMITTED, GL_PRIMITIVES_SUBMITTED,
+                                             GL_FRAGMENT_SHADER_INVOCATIONS};
+
+struct QuerySet {
+    GLuint Timer = 0;
+    std::array<GLuint, kStatCount> Stats{};
+};
+
+struct PassSlot {
+    std::array<QuerySet, GpuProfiler::kMaxQueriesPerPass> Queries;
+    uint32_t Issued = 0; // Query sets begun and ended this frame
+};
+
+struct FrameSlot {
+    std::array<PassSlot, kGpuPassCount> Passes;
+    bool WithStats = false;
+};
+
+// Only touched by the thread executing render commands (plus Shutdown, once that thread
+// is gone)
+struct QueryState {
+    bool Initialized = false;
+    bool StatsSupported = false;
+    std::array<FrameSlot, GpuProfiler::kFrameLatency> Frames;
+    uint32_t Current = 0;
+    int ActivePass = -1;
+};
+
+QueryState s_Queries;
+
+std::atomic<bool> s_StatsEnabled{false};
+std::atomic<bool> s_StatsSupported{false};
+std::atomic<uint64_t> s_DroppedFrames{0};
+
+std::mutex s_ResultsMutex;
+GpuFrameStats s_Results{};
+
+bool HasExtension(const char* name) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (extension && std::strcmp(extension, name) == 0)
+            return true;
+    }
+    return false;
+}
+
+void CreateQueries() {
+    // Same enums as the ARB extension, core since 4.6
+    s_Queries.StatsSupported =
+        GLAD_GL_VERSION_4_6 || HasExtension("GL_ARB_pipeline_statistics_query");
+    s_StatsSupported.store(s_Queries.StatsSupported);
+
+    for (FrameSlot& frame : s_Queries.Frames) {
+        for (PassSlot& pass : frame.Passes) {
+            for (QuerySet& set : pass.Queries) {
+                glGenQueries(1, &set.Timer);
+                if (s_Queries.StatsSupported)
+                    glGenQueries(kStatCount, set.Stats.data());
+            }
+        }
+    }
+    s_Queries.Initialized = true;
+
+    SE_LOG_INFO("GPU pass timing enabled (pipeline statistics {})",
+                s_Queries.StatsSupported ? "supported" : "unsupported");
+}
+
+bool IsAvailable(GLuint query) {
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available == GL_TRUE;
+}
+
+uint64_t ResultOf(GLuint query) {
+    GLuint64 value = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &value);
+    return value;
+}
+
+// Publish the results a slot holds from kFrameLatency frames ago, if they are all ready
+void CollectFrame(const FrameSlot& frame) {
+    bool issuedAny = false;
+    for (const PassSlot& pass : frame.Passes) {
+        for (uint32_t i = 0; i < pass.Issued; ++i) {
+            issuedAny = true;
+            const QuerySet& set = pass.Queries[i];
+            if (!IsAvailable(set.Timer) || (frame.WithStats && !IsAvailable(set.Stats.back()))) {
+                s_DroppedFrames.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    if (!issuedAny)
+        return;
+
+    GpuFrameStats results{};
+    for (size_t p = 0; p < kGpuPassCount; ++p) {
+        const PassSlot& pass = frame.Passes[p];
+        GpuPassStats& stats = results[p];
+        uint64_t nanoseconds = 0;
+        for (uint32_t i = 0; i < pass.Issued; ++i) {
+            const QuerySet& set = pass.Queries[i];
+            nanoseconds += ResultOf(set.Timer);
+            if (frame.WithStats) {
+                stats.VerticesSubmitted += ResultOf(set.Stats[0]);
+                stats.PrimitivesSubmitted += ResultOf(set.Stats[1]);
+                stats.FragmentInvocations += ResultOf(set.Stats[2]);
+            }
+        }
+        stats.Milliseconds = static_cast<float>(nanoseconds / 1.0e6);
+    }
+
+    std::lock_guard<std::mutex> lock(s_ResultsMutex);
+    s_Results = results;
+}
+
+void ExecuteBeginFrame(void*) {
+    if (!s_Queries.Initialized)
+        CreateQueries();
+
+    s_Queries.Current = (s_Queries.Current + 1) % GpuProfiler::kFrameLatency;
+    FrameSlot& frame = s_Queries.Frames[s_Queries.Current];
+    CollectFrame(frame);
+
+    for (PassSlot& pass : frame.Passes)
+        pass.Issued = 0;
+    frame.WithStats = s_Queries.StatsSupported && s_StatsEnabled.load();
+    s_Queries.ActivePass = -1;
+}
+
+void ExecuteBeginPass(void* userData) {
+    auto pass = reinterpret_cast<uintptr_t>(userData);
+    if (!s_Queries.Initialized || s_Queries.ActivePass >= 0)
+        return;
+
+    FrameSlot& frame = s_Queries.Frames[s_Queries.Current];
+    PassSlot& slot = frame.Passes[pass];
+    if (slot.Issued >= GpuProfiler::kMaxQueriesPerPass)
+        return;
+
+    const QuerySet& set = slot.Queries[slot.Issued];
+    glBeginQuery(GL_TIME_ELAPSED, set.Timer);
+    if (frame.WithStats) {
+        for (uint32_t i = 0; i < kStatCount; ++i)
+            glBeginQuery(kStatTargets[i], set.Stats[i]);
+    }
+    s_Queries.ActivePass = static_cast<int>(pass);
+}
+
+void ExecuteEndPass(void* userData) {
+    auto pass = reinterpret_cast<uintptr_t>(userData);
+    if (s_Queries.ActivePass != static_cast<int>(pass))
+        return;
+
+    FrameSlot& frame = s_Queries.Frames[s_Queries.Current];
+    glEndQuery(GL_TIME_ELAPSED);
+    if (frame.WithStats) {
+        for (GLenum target : kStatTargets)
+            glEndQuery(target);
+    }
+    frame.Passes[pass].Issued++;
+    s_Queries.ActivePass = -1;
+}
+
+void* PassData(GpuPass pass) {
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(pass));
+}
+
+} // namespace
+
+void GpuProfiler::BeginFrame() {
+    RenderCommand::Callback(&ExecuteBeginFrame, nullptr);
+}
+
+void GpuProfiler::BeginPass(GpuPass pass) {
+    RenderCounters::BeginPass(pass);
+    RenderCommand::Callback(&ExecuteBeginPass, PassData(pass));
+}
+
+void GpuProfiler::EndPass(GpuPass pass) {
+    RenderCommand::Callback(&ExecuteEndPass, PassData(pass));
+    RenderCounters::EndPass();
+}
+
+void GpuProfiler::SetPipelineStatistics(bool enabled) {
+    s_StatsEnabled.store(enabled);
+}
+
+bool GpuProfiler::IsPipelineStatisticsEnabled() {
+    return s_StatsEnabled.load();
+}
+
+bool GpuProfiler::IsPipelineStatisticsSupported() {
+    return s_StatsSupported.load();
+}
+
+GpuFrameStats GpuProfiler::GetResults() {
+    std::lock_guard<std::mutex> lock(s_ResultsMutex);
+    return s_Results;
+}
+
+uint64_t GpuProfiler::GetDroppedFrameCount() {
+    return s_DroppedFrames.load(std::memory_order_relaxed);
+}
+
+const char* GpuProfiler::GetPassName(GpuPass pass) {
+    switch (pass) {
+    case GpuPass::Shadow:
+        return "Shadow";
+    case GpuPass::Scene:
+        return "Scene";
+    case GpuPass::ImGui:
+        return "ImGui";
+    default:
+        return "Unknown";
+    }
+}
+
+void GpuProfiler::Shutdown() {
+    if (!s_Queries.Initialized)
+        return;
+
+    // A pass left open (frame abandoned mid-way) must end before its queries go
+    if (s_Queries.ActivePass >= 0)
+        ExecuteEndPass(PassData(static_cast<GpuPass>(s_Queries.ActivePass)));
+
+    for (FrameSlot& frame : s_Queries.Frames) {
+        for (PassSlot& pass : frame.Passes) {
+            for (QuerySet& set : pass.Queries) {
+                glDeleteQueries(1, &set.Timer);
+                if (s_Queries.StatsSupported)
+                    glDeleteQueries(kStatCount, set.Stats.data());
+            }
+        }
+    }
+    s_Queries = QueryState{};
+}
+
+} // namespace se
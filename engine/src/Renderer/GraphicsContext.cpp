@@ -1,25 +1,47 @@
 #include "engine/renderer/GraphicsContext.h"
 #include "engine/Log.h"
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
 #include <glad/glad.h>
 #include <stdexcept>
 
+#ifdef SE_HAS_EGL
+#    include <EGL/egl.h>
+#    include <EGL/eglext.h>
+#endif
+
 namespace se {
 
-GraphicsContext::GraphicsContext(GLFWwindow* windowHandle) : windowHandle_(windowHandle) {
+GraphicsContext::GraphicsContext(GLFWwindow* windowHandle, bool surfaceless)
+    : windowHandle_(windowHandle), surfaceless_(surfaceless) {
     if (!windowHandle_) {
         throw std::runtime_error("Window handle is null!");
     }
 }
 
-GraphicsContext::~GraphicsContext() {}
+GraphicsContext::~GraphicsContext() {
+    // Pending frame fences go away with the context
+#ifdef SE_HAS_EGL
+    if (eglDisplay_) {
+        eglMakeCurrent(eglDisplay_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (eglContext_)
+            eglDestroyContext(eglDisplay_, eglContext_);
+        eglTerminate(eglDisplay_);
+    }
+#endif
+}
 
 void GraphicsContext::Init() {
-    glfwMakeContextCurrent(windowHandle_);
+    if (surfaceless_) {
+        InitSurfaceless();
+    } else {
+        glfwMakeContextCurrent(windowHandle_);
 
-    // Initialize GLAD
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
-        throw std::runtime_error("Failed to initialize GLAD");
+        // Initialize GLAD
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            throw std::runtime_error("Failed to initialize GLAD");
+        }
     }
 
     SE_LOG_INFO("OpenGL Info:");
@@ -28,8 +50,139 @@ void GraphicsContext::Init() {
     SE_LOG_INFO("  Version: {}", (const char*)glGetString(GL_VERSION));
 }
 
+void GraphicsContext::MakeCurrent() {
+    if (!surfaceless_) {
+        glfwMakeContextCurrent(windowHandle_);
+        return;
+    }
+#ifdef SE_HAS_EGL
+    if (!eglMakeCurrent(eglDisplay_, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext_))
+        SE_LOG_ERROR("EGL: failed to make context current");
+#endif
+}
+
+void GraphicsContext::ReleaseCurrent() {
+    if (!surfaceless_) {
+        glfwMakeContextCurrent(nullptr);
+        return;
+    }
+#ifdef SE_HAS_EGL
+    eglMakeCurrent(eglDisplay_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+#endif
+}
+
+void GraphicsContext::InitSurfaceless() {
+#ifdef SE_HAS_EGL
+    // Prefer Mesa's surfaceless platform: it needs neither a display server nor a GPU
+    // (llvmpipe), which is exactly what CI/render-farm machines have.
+    EGLDisplay display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY)
+        throw std::runtime_error("EGL: no display available");
+
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(display, &major, &minor))
+        throw std::runtime_error("EGL: failed to initialize display");
+    eglDisplay_ = display;
+
+    SE_LOG_INFO("EGL {}.{} ({})", major, minor, eglQueryString(display, EGL_VENDOR));
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+        throw std::runtime_error("EGL: desktop OpenGL API not supported");
+
+    const EGLint configAttribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+        config = nullptr; // EGL_KHR_no_config_context
+
+    const EGLint contextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                     4,
+                                     EGL_CONTEXT_MINOR_VERSION,
+                                     5,
+                                     EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                     EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                     EGL_NONE};
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT)
+        throw std::runtime_error("EGL: failed to create an OpenGL 4.5 core context");
+    eglContext_ = context;
+
+    // EGL_KHR_surfaceless_context: no drawable at all, rendering goes to FBOs
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+        throw std::runtime_error("EGL: failed to make surfaceless context current");
+
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        throw std::runtime_error("Failed to initialize GLAD");
+    }
+#else
+    throw std::runtime_error("Surfaceless contexts require EGL support");
+#endif
+}
+
 void GraphicsContext::SwapBuffers() {
+    if (surfaceless_) {
+        // Nothing to present; wait for the GPU so frame times include the rendering work
+        glFinish();
+        return;
+    }
+
     glfwSwapBuffers(windowHandle_);
+    ThrottleFramesInFlight();
+}
+
+void GraphicsContext::SetMaxFramesInFlight(uint32_t frames) {
+    maxFramesInFlight_ = std::min(frames, kMaxFramesInFlight);
+
+    // Shrinking (or disabling) the limit: drop fences we no longer wait on
+    uint32_t keep = maxFramesInFlight_;
+    while (fenceCount_ > keep) {
+        glDeleteSync((GLsync)frameFences_[fenceHead_]);
+        frameFences_[fenceHead_] = nullptr;
+        fenceHead_ = (fenceHead_ + 1) % kMaxFramesInFlight;
+        fenceCount_--;
+    }
+}
+
+void GraphicsContext::ThrottleFramesInFlight() {
+    lastFenceWaitMs_.store(0.0f, std::memory_order_relaxed);
+    if (maxFramesInFlight_ == 0)
+        return;
+
+    uint32_t tail = (fenceHead_ + fenceCount_) % kMaxFramesInFlight;
+    frameFences_[tail] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    fenceCount_++;
+
+    auto start = std::chrono::steady_clock::now();
+    uint32_t timeouts = 0;
+    while (fenceCount_ > maxFramesInFlight_ - 1) {
+        GLsync fence = (GLsync)frameFences_[fenceHead_];
+        // Flush so the fence is guaranteed to signal; wait in 100 ms slices
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+        if (result == GL_TIMEOUT_EXPIRED && ++timeouts < kMaxFenceWaitSlices)
+            continue;
+        // A hung or lost GPU must not freeze the frame loop: give up on the fence
+        if (result == GL_TIMEOUT_EXPIRED)
+            SE_LOG_WARN("Frame fence not signaled after {} ms; dropping it",
+                        kMaxFenceWaitSlices * 100);
+        else if (result == GL_WAIT_FAILED)
+            SE_LOG_WARN("glClientWaitSync failed while throttling frames in flight");
+        timeouts = 0;
+
+        glDeleteSync(fence);
+        frameFences_[fenceHead_] = nullptr;
+        fenceHead_ = (fenceHead_ + 1) % kMaxFramesInFlight;
+        fenceCount_--;
+    }
+    float waitMs =
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    lastFenceWaitMs_.store(waitMs, std::memory_order_relaxed);
 }
 
-} // namespace se
\ No newline at end of file
+} // namespace se
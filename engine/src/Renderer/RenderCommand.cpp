@@ -1,64 +1,416 @@
 #include "engine/renderer/RenderCommand.h"
+#include "engine/memory/AllocationTracker.h"
+#include "engine/renderer/RenderCommandBuffer.h"
+#include "engine/renderer/RenderCounters.h"
 #include "engine/renderer/VertexArray.h"
+#include <cstring>
 #include <glad/glad.h>
+#include <gtc/type_ptr.hpp>
 
 namespace se {
 
+namespace {
+
+struct ViewportCmd {
+    glm::ivec4 Rect;
+};
+struct ColorCmd {
+    glm::vec4 Color;
+};
+struct EmptyCmd {};
+struct DrawCmd {
+    uint32_t VertexArray;
+    uint32_t Count;
+};
+struct ToggleCmd {
+    bool Enabled;
+};
+struct CullModeCmd {
+    CullFaceMode Mode;
+};
+struct HandleCmd {
+    uint32_t Handle;
+};
+struct TextureCmd {
+    uint32_t Slot;
+    uint32_t Texture;
+};
+template <typename T>
+struct UniformCmd {
+    uint32_t Program;
+    T Value;
+    // Followed by the null-terminated uniform name
+};
+struct CallbackCmd {
+    void (*Function)(void*);
+    void* UserData;
+};
+
+RenderCommandBuffer* s_RecordTarget = nullptr;
+
+// Shadow of the state set through RenderCommand (see RenderCommand::GetViewport)
+glm::ivec4 s_Viewport{0};
+uint32_t s_Framebuffer = 0;
+bool s_CullFace = false;
+CullFaceMode s_CullFaceMode = CullFaceMode::Back;
+
+void ApplyToggle(GLenum capability, bool enabled) {
+    if (enabled)
+        glEnable(capability);
+    else
+        glDisable(capability);
+}
+
+void ApplyDraw(const DrawCmd& cmd, bool indexed) {
+    glBindVertexArray(cmd.VertexArray);
+    if (indexed)
+        glDrawElements(GL_TRIANGLES, cmd.Count, GL_UNSIGNED_INT, nullptr);
+    else
+        glDrawArrays(GL_TRIANGLES, 0, cmd.Count);
+}
+
+// Every draw binds its vertex array (see ApplyDraw)
+void CountDraw(uint32_t count) {
+    PassCounters& counters = RenderCounters::Active();
+    counters.DrawCalls++;
+    counters.VertexArrayBinds++;
+    counters.Triangles += count / 3;
+}
+
+void ApplyUniform(uint32_t program, const char* name, float value) {
+    glUniform1f(glGetUniformLocation(program, name), value);
+}
+void ApplyUniform(uint32_t program, const char* name, int value) {
+    glUniform1i(glGetUniformLocation(program, name), value);
+}
+void ApplyUniform(uint32_t program, const char* name, const glm::vec3& value) {
+    glUniform3fv(glGetUniformLocation(program, name), 1, glm::value_ptr(value));
+}
+void ApplyUniform(uint32_t program, const char* name, const glm::vec4& value) {
+    glUniform4fv(glGetUniformLocation(program, name), 1, glm::value_ptr(value));
+}
+void ApplyUniform(uint32_t program, const char* name, const glm::mat4& value) {
+    glUniformMatrix4fv(glGetUniformLocation(program, name), 1, GL_FALSE, glm::value_ptr(value));
+}
+
+template <typename T>
+void SetUniformImpl(RenderCommandType type, uint32_t program, const char* name, const T& value) {
+    if (!program)
+        return;
+
+    PassCounters& counters = RenderCounters::Active();
+    counters.UniformUploads++;
+    counters.UniformBytes += sizeof(T);
+
+    if (s_RecordTarget) {
+        UniformCmd<T> cmd{program, value};
+        s_RecordTarget->Push(type, cmd, name, static_cast<uint32_t>(std::strlen(name) + 1));
+        return;
+    }
+    ApplyUniform(program, name, value);
+}
+
+template <typename T>
+T Read(const uint8_t* payload) {
+    T value;
+    std::memcpy(&value, payload, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void ExecuteUniform(const uint8_t* payload) {
+    auto cmd = Read<UniformCmd<T>>(payload);
+    ApplyUniform(cmd.Program, reinterpret_cast<const char*>(payload + sizeof(UniformCmd<T>)),
+                 cmd.Value);
+}
+
+} // namespace
+
 void RenderCommand::Init() {
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Seed the state shadow from whatever the context starts with
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    s_Viewport = {viewport[0], viewport[1], viewport[2], viewport[3]};
+    GLint framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+    s_Framebuffer = static_cast<uint32_t>(framebuffer);
+    s_CullFace = glIsEnabled(GL_CULL_FACE);
+    s_CullFaceMode = CullFaceMode::Back;
+    glCullFace(GL_BACK);
 }
 
 void RenderCommand::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    s_Viewport = {(int)x, (int)y, (int)width, (int)height};
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetViewport, ViewportCmd{s_Viewport});
+        return;
+    }
     glViewport(x, y, width, height);
 }
 
 void RenderCommand::SetClearColor(const glm::vec4& color) {
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetClearColor, ColorCmd{color});
+        return;
+    }
     glClearColor(color.r, color.g, color.b, color.a);
 }
 
 void RenderCommand::Clear() {
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::Clear, EmptyCmd{});
+        return;
+    }
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void RenderCommand::ClearDepth() {
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::ClearDepth, EmptyCmd{});
+        return;
+    }
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
 void RenderCommand::DrawIndexed(const VertexArray* vertexArray, uint32_t indexCount) {
-    vertexArray->Bind();
     uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
-    glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
+    DrawCmd cmd{vertexArray->GetRendererID(), count};
+    CountDraw(count);
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::DrawIndexed, cmd);
+        return;
+    }
+    ApplyDraw(cmd, true);
 }
 
 void RenderCommand::DrawArrays(const VertexArray* vertexArray, uint32_t vertexCount) {
-    vertexArray->Bind();
-    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    DrawCmd cmd{vertexArray->GetRendererID(), vertexCount};
+    CountDraw(vertexCount);
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::DrawArrays, cmd);
+        return;
+    }
+    ApplyDraw(cmd, false);
 }
 
 void RenderCommand::SetDepthTest(bool enabled) {
-    if (enabled)
-        glEnable(GL_DEPTH_TEST);
-    else
-        glDisable(GL_DEPTH_TEST);
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetDepthTest, ToggleCmd{enabled});
+        return;
+    }
+    ApplyToggle(GL_DEPTH_TEST, enabled);
 }
 
 void RenderCommand::SetBlend(bool enabled) {
-    if (enabled)
-        glEnable(GL_BLEND);
-    else
-        glDisable(GL_BLEND);
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetBlend, ToggleCmd{enabled});
+        return;
+    }
+    ApplyToggle(GL_BLEND, enabled);
 }
 
 void RenderCommand::SetCullFace(bool enabled) {
-    if (enabled)
-        glEnable(GL_CULL_FACE);
-    else
-        glDisable(GL_CULL_FACE);
+    s_CullFace = enabled;
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetCullFace, ToggleCmd{enabled});
+        return;
+    }
+    ApplyToggle(GL_CULL_FACE, enabled);
+}
+
+void RenderCommand::SetCullFaceMode(CullFaceMode mode) {
+    s_CullFaceMode = mode;
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetCullFaceMode, CullModeCmd{mode});
+        return;
+    }
+    glCullFace(mode == CullFaceMode::Front ? GL_FRONT : GL_BACK);
 }
 
 void RenderCommand::SetWireframe(bool enabled) {
-    if (enabled)
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    else
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::SetWireframe, ToggleCmd{enabled});
+        return;
+    }
+    glPolygonMode(GL_FRONT_AND_BACK, enabled ? GL_LINE : GL_FILL);
+}
+
+void RenderCommand::BindFramebuffer(uint32_t framebuffer) {
+    s_Framebuffer = framebuffer;
+    RenderCounters::Active().FramebufferBinds++;
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::BindFramebuffer, HandleCmd{framebuffer});
+        return;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
+void RenderCommand::BindTexture2D(uint32_t slot, uint32_t texture) {
+    RenderCounters::Active().TextureBinds++;
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::BindTexture2D, TextureCmd{slot, texture});
+        return;
+    }
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void RenderCommand::UseProgram(uint32_t program) {
+    RenderCounters::Active().ProgramBinds++;
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::UseProgram, HandleCmd{program});
+        return;
+    }
+    glUseProgram(program);
+}
+
+void RenderCommand::SetUniform(uint32_t program, const char* name, float value) {
+    SetUniformImpl(RenderCommandType::SetUniformFloat, program, name, value);
+}
+
+void RenderCommand::SetUniform(uint32_t program, const char* name, int value) {
+    SetUniformImpl(RenderCommandType::SetUniformInt, program, name, value);
+}
+
+void RenderCommand::SetUniform(uint32_t program, const char* name, const glm::vec3& value) {
+    SetUniformImpl(RenderCommandType::SetUniformVec3, program, name, value);
+}
+
+void RenderCommand::SetUniform(uint32_t program, const char* name, const glm::vec4& value) {
+    SetUniformImpl(RenderCommandType::SetUniformVec4, program, name, value);
+}
+
+void RenderCommand::SetUniform(uint32_t program, const char* name, const glm::mat4& value) {
+    SetUniformImpl(RenderCommandType::SetUniformMat4, program, name, value);
+}
+
+void RenderCommand::Callback(void (*function)(void*), void* userData) {
+    if (s_RecordTarget) {
+        s_RecordTarget->Push(RenderCommandType::Callback, CallbackCmd{function, userData});
+        return;
+    }
+    function(userData);
+}
+
+void RenderCommand::Retain(std::shared_ptr<const void> resource) {
+    if (s_RecordTarget)
+        s_RecordTarget->Retain(std::move(resource));
+}
+
+glm::ivec4 RenderCommand::GetViewport() {
+    return s_Viewport;
+}
+
+uint32_t RenderCommand::GetFramebuffer() {
+    return s_Framebuffer;
+}
+
+bool RenderCommand::IsCullFaceEnabled() {
+    return s_CullFace;
+}
+
+CullFaceMode RenderCommand::GetCullFaceMode() {
+    return s_CullFaceMode;
+}
+
+void RenderCommand::SetRecordTarget(RenderCommandBuffer* buffer) {
+    s_RecordTarget = buffer;
+}
+
+bool RenderCommand::IsRecording() {
+    return s_RecordTarget != nullptr;
+}
+
+void RenderCommand::Execute(const RenderCommandBuffer& buffer) {
+    SE_ALLOC_TAG(Render);
+    SE_ZERO_ALLOC_SCOPE("RenderCommand::Execute");
+
+    const uint8_t* cursor = buffer.GetData();
+    const uint8_t* end = cursor + buffer.GetSize();
+
+    while (cursor < end) {
+        auto header = Read<RenderCommandBuffer::Header>(cursor);
+        const uint8_t* payload = cursor + sizeof(RenderCommandBuffer::Header);
+        cursor = payload + header.Size;
+
+        switch (header.Type) {
+            case RenderCommandType::SetViewport: {
+                glm::ivec4 rect = Read<ViewportCmd>(payload).Rect;
+                glViewport(rect.x, rect.y, rect.z, rect.w);
+                break;
+            }
+            case RenderCommandType::SetClearColor: {
+                glm::vec4 color = Read<ColorCmd>(payload).Color;
+                glClearColor(color.r, color.g, color.b, color.a);
+                break;
+            }
+            case RenderCommandType::Clear:
+                glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                break;
+            case RenderCommandType::ClearDepth:
+                glClear(GL_DEPTH_BUFFER_BIT);
+                break;
+            case RenderCommandType::DrawIndexed:
+                ApplyDraw(Read<DrawCmd>(payload), true);
+                break;
+            case RenderCommandType::DrawArrays:
+                ApplyDraw(Read<DrawCmd>(payload), false);
+                break;
+            case RenderCommandType::SetDepthTest:
+                ApplyToggle(GL_DEPTH_TEST, Read<ToggleCmd>(payload).Enabled);
+                break;
+            case RenderCommandType::SetBlend:
+                ApplyToggle(GL_BLEND, Read<ToggleCmd>(payload).Enabled);
+                break;
+            case RenderCommandType::SetCullFace:
+                ApplyToggle(GL_CULL_FACE, Read<ToggleCmd>(payload).Enabled);
+                break;
+            case RenderCommandType::SetCullFaceMode:
+                glCullFace(Read<CullModeCmd>(payload).Mode == CullFaceMode::Front ? GL_FRONT
+                                                                                  : GL_BACK);
+                break;
+            case RenderCommandType::SetWireframe:
+                glPolygonMode(GL_FRONT_AND_BACK,
+                              Read<ToggleCmd>(payload).Enabled ? GL_LINE : GL_FILL);
+                break;
+            case RenderCommandType::BindFramebuffer:
+                glBindFramebuffer(GL_FRAMEBUFFER, Read<HandleCmd>(payload).Handle);
+                break;
+            case RenderCommandType::BindTexture2D: {
+                auto cmd = Read<TextureCmd>(payload);
+                glActiveTexture(GL_TEXTURE0 + cmd.Slot);
+                glBindTexture(GL_TEXTURE_2D, cmd.Texture);
+                break;
+            }
+            case RenderCommandType::UseProgram:
+                glUseProgram(Read<HandleCmd>(payload).Handle);
+                break;
+            case RenderCommandType::SetUniformFloat:
+                ExecuteUniform<float>(payload);
+                break;
+            case RenderCommandType::SetUniformInt:
+                ExecuteUniform<int>(payload);
+                break;
+            case RenderCommandType::SetUniformVec3:
+                ExecuteUniform<glm::vec3>(payload);
+                break;
+            case RenderCommandType::SetUniformVec4:
+                ExecuteUniform<glm::vec4>(payload);
+                break;
+            case RenderCommandType::SetUniformMat4:
+                ExecuteUniform<glm::mat4>(payload);
+                break;
+            case RenderCommandType::Callback: {
+                auto cmd = Read<CallbackCmd>(payload);
+                cmd.Function(cmd.UserData);
+                break;
+            }
+        }
+    }
 }
 
-} // namespace se
\ No newline at end of file
+} // namespace se
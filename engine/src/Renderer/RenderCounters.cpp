@@ -0,0 +1,75 @@
+#include "engine/renderer/RenderCounters.h"
+
+namespace se {
+
+namespace {
+
+std::array<FrameCounters, RenderCounters::kHistorySize> s_History{};
+uint32_t s_HistoryHead = 0; // Next slot to write
+uint32_t s_HistoryCount = 0;
+
+} // namespace
+
+FrameCounters RenderCounters::current_{};
+PassCounters* RenderCounters::active_ = &RenderCounters::current_.Passes[kUnscopedPass];
+
+PassCounters& PassCounters::operator+=(const PassCounters& other) {
+    DrawCalls += other.DrawCalls;
+    Triangles += other.Triangles;
+    ProgramBinds += other.ProgramBinds;
+    VertexArrayBinds += other.VertexArrayBinds;
+    TextureBinds += other.TextureBinds;
+    FramebufferBinds += other.FramebufferBinds;
+    UniformUploads += other.UniformUploads;
+    UniformBytes += other.UniformBytes;
+    BufferUploads += other.BufferUploads;
+    BufferBytes += other.BufferBytes;
+    return *this;
+}
+
+PassCounters FrameCounters::Total() const {
+    PassCounters total;
+    for (const PassCounters& pass : Passes)
+        total += pass;
+    return total;
+}
+
+void RenderCounters::BeginPass(GpuPass pass) {
+    active_ = &current_.Passes[static_cast<size_t>(pass)];
+}
+
+void RenderCounters::EndPass() {
+    active_ = &current_.Passes[kUnscopedPass];
+}
+
+void RenderCounters::EndFrame() {
+    uint64_t frame = current_.Frame;
+    s_History[s_HistoryHead] = current_;
+    s_HistoryHead = (s_HistoryHead + 1) % kHistorySize;
+    if (s_HistoryCount < kHistorySize)
+        s_HistoryCount++;
+
+    current_ = FrameCounters{};
+    current_.Frame = frame + 1;
+    active_ = &current_.Passes[kUnscopedPass];
+}
+
+const FrameCounters& RenderCounters::GetLastFrame() {
+    static const FrameCounters kEmpty{};
+    return s_HistoryCount > 0 ? GetHistory(0) : kEmpty;
+}
+
+const FrameCounters& RenderCounters::GetHistory(uint32_t age) {
+    return s_History[(s_HistoryHead + kHistorySize - 1 - age) % kHistorySize];
+}
+
+uint32_t RenderCounters::GetHistoryCount() {
+    return s_HistoryCount;
+}
+
+const char* RenderCounters::GetPassName(size_t pass) {
+    return pass < kGpuPassCount ? GpuProfiler::GetPassName(static_cast<GpuPass>(pass))
+                                : "Other";
+}
+
+} // namespace se
@@ -0,0 +1,105 @@
+#include "engine/renderer/RenderThread.h"
+#include "engine/Log.h"
+#include "engine/Profiler.h"
+#include "engine/Window.h"
+#include "engine/renderer/RenderCommand.h"
+#include "engine/renderer/RenderCommandBuffer.h"
+#include <chrono>
+
+#ifdef __linux__
+#    include <pthread.h>
+#endif
+
+namespace se {
+
+RenderThread::RenderThread(Window& window) : window_(window) {}
+
+RenderThread::~RenderThread() {
+    if (IsRunning())
+        Stop();
+}
+
+void RenderThread::Start() {
+    if (IsRunning())
+        return;
+
+    window_.ReleaseContext();
+    stopping_ = false;
+    thread_ = std::thread(&RenderThread::ThreadLoop, this);
+#ifdef __linux__
+    pthread_setname_np(thread_.native_handle(), "se-render");
+#endif
+
+    SE_LOG_INFO("Render thread started");
+}
+
+void RenderThread::Stop() {
+    if (!IsRunning())
+        return;
+
+    WaitIdle();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    workReady_.notify_one();
+    thread_.join();
+
+    window_.MakeContextCurrent();
+    SE_LOG_INFO("Render thread stopped");
+}
+
+void RenderThread::Submit(const RenderCommandBuffer& buffer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = &buffer;
+        busy_ = true;
+    }
+    workReady_.notify_one();
+}
+
+void RenderThread::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    workDone_.wait(lock, [this]() { return !busy_; });
+}
+
+void RenderThread::ThreadLoop() {
+    Profiler::SetThreadName("Render");
+
+    while (true) {
+        const RenderCommandBuffer* buffer = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            workReady_.wait(lock, [this]() { return stopping_ || pending_ != nullptr; });
+            if (stopping_)
+                break;
+            buffer = pending_;
+            pending_ = nullptr;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        {
+            SE_PROFILE_SCOPE("RenderThread::Execute");
+            window_.MakeContextCurrent();
+            RenderCommand::Execute(*buffer);
+        }
+        {
+            SE_PROFILE_SCOPE("RenderThread::SwapBuffers");
+            window_.SwapBuffers();
+            window_.ReleaseContext();
+        }
+
+        lastFrameMs_ = std::chrono::duration<float, std::milli>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_ = false;
+        }
+        workDone_.notify_all();
+    }
+}
+
+} // namespace se
@@ -1,8 +1,16 @@
 #include "engine/renderer/SceneRenderer.h"
+#include "engine/HardwareCounters.h"
+#include "engine/Log.h"
+#include "engine/MainThreadQueue.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
+#include "engine/renderer/FrameCapture.h"
+#include "engine/renderer/GpuProfiler.h"
 #include "engine/renderer/RenderCommand.h"
 #include <glad/glad.h>
 #include <gtc/matrix_transform.hpp>
 #include <gtc/type_ptr.hpp>
+#include <unordered_map>
 
 namespace {
 constexpr const char* kShadowVertexSource = R"(#version 330 core
@@ -22,6 +30,29 @@ void main() {
     // depth only
 }
 )";
+
+// A captured scene waiting for its mesh data, which only the thread owning the GL context
+// can read back
+struct PendingCapture {
+    se::CapturedFrame Frame;
+    std::vector<std::shared_ptr<se::VertexArray>> Meshes;
+    std::filesystem::path Path;
+};
+
+void FinishCapture(void* userData) {
+    std::unique_ptr<PendingCapture> capture(static_cast<PendingCapture*>(userData));
+    se::CapturedFrame& frame = capture->Frame;
+    frame.Meshes.reserve(capture->Meshes.size());
+    for (const auto& vertexArray : capture->Meshes)
+        frame.Meshes.push_back(se::FrameCapture::ReadBack(*vertexArray));
+
+    if (se::FrameCapture::Save(frame, capture->Path)) {
+        SE_LOG_INFO("Captured scene to '{}': {} submissions, {} meshes, {} materials, "
+                    "{} shaders",
+                    capture->Path.string(), frame.Submissions.size(), frame.Meshes.size(),
+                    frame.Materials.size(), frame.Shaders.size());
+    }
+}
 } // namespace
 
 namespace se {
@@ -29,8 +60,8 @@ SceneRenderer::SceneData* SceneRenderer::sceneData_ = nullptr;
 RenderStats SceneRenderer::stats_;
 
 void SceneRenderer::Init() {
+    // Shadow resources are created by the first scene that actually casts shadows
     sceneData_ = new SceneData();
-    InitializeShadowResources();
 }
 
 void SceneRenderer::Shutdown() {
@@ -40,10 +71,20 @@ void SceneRenderer::Shutdown() {
 }
 
 void SceneRenderer::BeginScene(const Camera& camera, const glm::mat4& projection) {
-    sceneData_->ViewMatrix = camera.getViewMatrix();
+    BeginScene(camera.getViewMatrix(), projection);
+}
+
+void SceneRenderer::BeginScene(const glm::mat4& view, const glm::mat4& projection) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Render);
+
+    sceneData_->ViewMatrix = view;
     sceneData_->ProjectionMatrix = projection;
     sceneData_->view_projection_matrix = projection * sceneData_->ViewMatrix;
-    sceneData_->Submissions.clear();
+
+    // One arena allocation sized from the previous scene instead of regrowing
+    sceneData_->Submissions = FrameVector<Submission>();
+    sceneData_->Submissions.reserve(sceneData_->LastSubmissionCount);
 
     // Prepare directional light data and shadow matrix
     if (!sceneData_->directional_light.Active) {
@@ -85,14 +126,59 @@ void SceneRenderer::BeginScene(const Camera& camera, const glm::mat4& projection
 }
 
 void SceneRenderer::EndScene() {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Render);
+    // Captures are one-off and allocate freely, so they run ahead of the zero-alloc scope
+    if (sceneData_ && !sceneData_->CapturePath.empty())
+        CaptureScene();
+
+    // Once warmed up, recording the passes must not touch the heap
+    SE_ZERO_ALLOC_SCOPE("SceneRenderer::EndScene");
+    SE_COUNTERS_SCOPE("SceneRenderer::EndScene");
+
     if (!sceneData_)
         return;
 
+    if (sceneData_->ShadowsEnabled && !sceneData_->ShadowFramebuffer) {
+        if (!RenderCommand::IsRecording()) {
+            InitializeShadowResources();
+        } else if (!sceneData_->ShadowResourcesQueued) {
+            // No GL context while recording for the render thread: create them at the next
+            // sync point and render this frame without shadows
+            sceneData_->ShadowResourcesQueued = true;
+            if (MainThreadQueue* queue = MainThreadQueue::Get()) {
+                queue->Enqueue(
+                    []() {
+                        InitializeShadowResources();
+                        return TaskStatus::Done;
+                    },
+                    TaskPriority::High);
+            }
+        }
+    }
+
+    if (!sceneData_->ShadowFramebuffer) {
+        sceneData_->ShadowsEnabled = false;
+    }
+
+    uint64_t passStart = Profiler::Now();
     if (sceneData_->ShadowsEnabled) {
+        GpuProfiler::BeginPass(GpuPass::Shadow);
         RenderShadowPass();
+        GpuProfiler::EndPass(GpuPass::Shadow);
     }
 
+    uint64_t shadowEnd = Profiler::Now();
+    GpuProfiler::BeginPass(GpuPass::Scene);
     RenderScenePass();
+    GpuProfiler::EndPass(GpuPass::Scene);
+
+    stats_.ShadowPassMs += static_cast<float>((shadowEnd - passStart) / 1.0e6);
+    stats_.ScenePassMs += static_cast<float>((Profiler::Now() - shadowEnd) / 1.0e6);
+
+    // Drop the references now; the memory goes back with the arena block
+    sceneData_->LastSubmissionCount = sceneData_->Submissions.size();
+    sceneData_->Submissions = FrameVector<Submission>();
 }
 
 void SceneRenderer::Submit(const std::shared_ptr<VertexArray>& vertexArray,
@@ -108,6 +194,7 @@ void SceneRenderer::Submit(const std::shared_ptr<VertexArray>& vertexArray,
     submission.CastsShadows = castsShadows;
     submission.ReceiveShadows = receiveShadows;
     sceneData_->Submissions.emplace_back(std::move(submission));
+    RenderCounters::AddSubmitted();
 }
 
 void SceneRenderer::SetDirectionalLight(const DirectionalLightData& light) {
@@ -136,6 +223,13 @@ void SceneRenderer::ClearDirectionalLight() {
     sceneData_->LightSpaceMatrix = glm::mat4(1.0f);
 }
 
+void SceneRenderer::CaptureNextScene(const std::filesystem::path& path) {
+    if (!sceneData_)
+        return;
+
+    sceneData_->CapturePath = path;
+}
+
 SceneRenderer::DirectionalLightData SceneRenderer::GetDirectionalLight() {
     if (!sceneData_)
         return DirectionalLightData{};
@@ -144,7 +238,7 @@ SceneRenderer::DirectionalLightData SceneRenderer::GetDirectionalLight() {
 }
 
 void SceneRenderer::InitializeShadowResources() {
-    if (!sceneData_)
+    if (!sceneData_ || sceneData_->ShadowFramebuffer)
         return;
 
     sceneData_->ShadowShader = std::make_shared<Shader>(kShadowVertexSource, kShadowFragmentSource);
@@ -167,7 +261,8 @@ void SceneRenderer::InitializeShadowResources() {
                            sceneData_->ShadowDepthTexture, 0);
     glDrawBuffer(GL_NONE);
     glReadBuffer(GL_NONE);
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    // Created mid-frame: put back whatever target the frame is rendering into
+    glBindFramebuffer(GL_FRAMEBUFFER, RenderCommand::GetFramebuffer());
 }
 
 void SceneRenderer::DestroyShadowResources() {
@@ -186,26 +281,27 @@ void SceneRenderer::DestroyShadowResources() {
 }
 
 void SceneRenderer::RenderShadowPass() {
+    SE_PROFILE_FUNCTION();
+
     if (!sceneData_ || sceneData_->Submissions.empty())
         return;
 
     if (!sceneData_->ShadowShader || !sceneData_->ShadowFramebuffer)
         return;
 
-    GLint previousViewport[4];
-    glGetIntegerv(GL_VIEWPORT, previousViewport);
-
-    glViewport(0, 0, sceneData_->ShadowMapSize.x, sceneData_->ShadowMapSize.y);
-    glBindFramebuffer(GL_FRAMEBUFFER, sceneData_->ShadowFramebuffer);
-    glClear(GL_DEPTH_BUFFER_BIT);
+    // Restore through RenderCommand's state shadow rather than glGet*, so the pass can be
+    // recorded. The scene pass may target an offscreen framebuffer (e.g. headless runs).
+    glm::ivec4 previousViewport = RenderCommand::GetViewport();
+    uint32_t previousFramebuffer = RenderCommand::GetFramebuffer();
+    bool wasCullEnabled = RenderCommand::IsCullFaceEnabled();
+    CullFaceMode previousCullFaceMode = RenderCommand::GetCullFaceMode();
 
-    GLboolean wasCullEnabled = glIsEnabled(GL_CULL_FACE);
-    GLint previousCullFaceMode = GL_BACK;
-    if (wasCullEnabled)
-        glGetIntegerv(GL_CULL_FACE_MODE, &previousCullFaceMode);
+    RenderCommand::SetViewport(0, 0, sceneData_->ShadowMapSize.x, sceneData_->ShadowMapSize.y);
+    RenderCommand::BindFramebuffer(sceneData_->ShadowFramebuffer);
+    RenderCommand::ClearDepth();
 
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_FRONT);
+    RenderCommand::SetCullFace(true);
+    RenderCommand::SetCullFaceMode(CullFaceMode::Front);
 
     sceneData_->ShadowShader->bind();
     sceneData_->ShadowShader->setMat4("uLightSpaceMatrix", sceneData_->LightSpaceMatrix);
@@ -219,25 +315,31 @@ void SceneRenderer::RenderShadowPass() {
 
         sceneData_->ShadowShader->setMat4("uModel", submission.Transform);
         RenderCommand::DrawIndexed(submission.vertex_array.get());
+        // Shadow-only submissions are never retained by the scene pass
+        RenderCommand::Retain(submission.vertex_array);
+
+        stats_.DrawCalls++;
+        stats_.TriangleCount += submission.vertex_array->GetIndexBuffer()->GetCount() / 3;
     }
 
-    glCullFace(previousCullFaceMode);
-    if (!wasCullEnabled)
-        glDisable(GL_CULL_FACE);
+    RenderCommand::SetCullFaceMode(previousCullFaceMode);
+    RenderCommand::SetCullFace(wasCullEnabled);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    RenderCommand::BindFramebuffer(previousFramebuffer);
+    RenderCommand::SetViewport(previousViewport.x, previousViewport.y, previousViewport.z,
+                               previousViewport.w);
 }
 
 void SceneRenderer::RenderScenePass() {
+    SE_PROFILE_FUNCTION();
+
     if (!sceneData_)
         return;
 
-    glActiveTexture(GL_TEXTURE0);
     if (sceneData_->ShadowsEnabled && sceneData_->ShadowDepthTexture)
-        glBindTexture(GL_TEXTURE_2D, sceneData_->ShadowDepthTexture);
+        RenderCommand::BindTexture2D(0, sceneData_->ShadowDepthTexture);
     else
-        glBindTexture(GL_TEXTURE_2D, 0);
+        RenderCommand::BindTexture2D(0, 0);
 
     for (const auto& submission : sceneData_->Submissions) {
         if (!submission.vertex_array || !submission.material)
@@ -265,11 +367,83 @@ void SceneRenderer::RenderScenePass() {
                                                                                            : 0.0f);
 
         RenderCommand::DrawIndexed(submission.vertex_array.get());
+        // Recorded draws reference GL objects by id; keep them alive until executed
+        RenderCommand::Retain(submission.vertex_array);
+        RenderCommand::Retain(shader);
 
         stats_.DrawCalls++;
         stats_.TriangleCount += submission.vertex_array->GetIndexBuffer()->GetCount() / 3;
     }
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    RenderCommand::BindTexture2D(0, 0);
+}
+
+void SceneRenderer::CaptureScene() {
+    SE_PROFILE_FUNCTION();
+
+    auto capture = std::make_unique<PendingCapture>();
+    capture->Path = std::move(sceneData_->CapturePath);
+    sceneData_->CapturePath.clear();
+
+    CapturedFrame& frame = capture->Frame;
+    frame.ViewMatrix = sceneData_->ViewMatrix;
+    frame.ProjectionMatrix = sceneData_->ProjectionMatrix;
+    frame.DirectionalLight = sceneData_->directional_light;
+    glm::ivec4 viewport = RenderCommand::GetViewport();
+    frame.ViewportSize = {viewport.z, viewport.w};
+
+    // Meshes, materials and shaders are stored once and referenced by index
+    std::unordered_map<const VertexArray*, uint32_t> meshIndices;
+    std::unordered_map<const Material*, uint32_t> materialIndices;
+    std::unordered_map<const Shader*, uint32_t> shaderIndices;
+
+    auto captureShader = [&](const Shader& shader) {
+        auto [it, inserted] = shaderIndices.try_emplace(&shader, frame.Shaders.size());
+        if (inserted)
+            frame.Shaders.push_back({shader.getVertexSource(), shader.getFragmentSource()});
+        return it->second;
+    };
+    auto captureMaterial = [&](const Material& material) {
+        auto [it, inserted] = materialIndices.try_emplace(&material, frame.Materials.size());
+        if (inserted) {
+            CapturedMaterial captured;
+            captured.Shader = captureShader(*material.GetShader());
+            captured.Floats.assign(material.GetFloats().begin(), material.GetFloats().end());
+            captured.Ints.assign(material.GetInts().begin(), material.GetInts().end());
+            captured.Vector3s.assign(material.GetVector3s().begin(),
+                                     material.GetVector3s().end());
+            captured.Vector4s.assign(material.GetVector4s().begin(),
+                                     material.GetVector4s().end());
+            captured.Matrix4s.assign(material.GetMatrix4s().begin(),
+                                     material.GetMatrix4s().end());
+            frame.Materials.push_back(std::move(captured));
+        }
+        return it->second;
+    };
+
+    // Neither pass draws a submission without a mesh. One without a material (or shader)
+    // still casts shadows, so it is kept with kNoMaterial.
+    frame.Submissions.reserve(sceneData_->Submissions.size());
+    for (const auto& submission : sceneData_->Submissions) {
+        if (!submission.vertex_array)
+            continue;
+
+        CapturedSubmission captured;
+        auto [mesh, inserted] =
+            meshIndices.try_emplace(submission.vertex_array.get(), capture->Meshes.size());
+        if (inserted)
+            capture->Meshes.push_back(submission.vertex_array);
+        captured.Mesh = mesh->second;
+        captured.Material = submission.material && submission.material->GetShader()
+                                ? captureMaterial(*submission.material)
+                                : CapturedSubmission::kNoMaterial;
+        captured.Transform = submission.Transform;
+        captured.CastsShadows = submission.CastsShadows;
+        captured.ReceiveShadows = submission.ReceiveShadows;
+        frame.Submissions.push_back(captured);
+    }
+
+    // Immediate mode finishes right here; with a render thread, when the frame executes
+    RenderCommand::Callback(FinishCapture, capture.release());
 }
 } // namespace se
@@ -70,7 +70,8 @@ Framebuffer CreateFramebufferWithTexture(const Texture texture) {
 bool AttachTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture) {
     glNamedFramebufferTexture(framebuffer.Handle, GL_COLOR_ATTACHMENT0, texture.Handle, 0);
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    if (glCheckNamedFramebufferStatus(framebuffer.Handle, GL_FRAMEBUFFER) !=
+        GL_FRAMEBUFFER_COMPLETE) {
         std::cerr << "Framebuffer is not complete!" << std::endl;
         return false;
     }
@@ -79,6 +80,36 @@ bool AttachTextureToFramebuffer(Framebuffer& framebuffer, const Texture texture)
     return true;
 }
 
+bool AttachDepthBufferToFramebuffer(Framebuffer& framebuffer, uint32_t width, uint32_t height) {
+    GLuint renderbuffer = 0;
+    glCreateRenderbuffers(1, &renderbuffer);
+    glNamedRenderbufferStorage(renderbuffer, GL_DEPTH24_STENCIL8, width, height);
+    glNamedFramebufferRenderbuffer(framebuffer.Handle, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                                   renderbuffer);
+
+    if (glCheckNamedFramebufferStatus(framebuffer.Handle, GL_FRAMEBUFFER) !=
+        GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Framebuffer is not complete after depth attachment!" << std::endl;
+        glDeleteRenderbuffers(1, &renderbuffer);
+        return false;
+    }
+
+    if (framebuffer.DepthAttachment)
+        glDeleteRenderbuffers(1, &framebuffer.DepthAttachment);
+    framebuffer.DepthAttachment = renderbuffer;
+    return true;
+}
+
+void DestroyFramebuffer(Framebuffer& framebuffer) {
+    if (framebuffer.DepthAttachment)
+        glDeleteRenderbuffers(1, &framebuffer.DepthAttachment);
+    if (framebuffer.ColorAttachment.Handle)
+        glDeleteTextures(1, &framebuffer.ColorAttachment.Handle);
+    if (framebuffer.Handle)
+        glDeleteFramebuffers(1, &framebuffer.Handle);
+    framebuffer = {};
+}
+
 void BlitFramebufferToSwapchain(const Framebuffer framebuffer) {
     glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer.Handle);
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // swapchain
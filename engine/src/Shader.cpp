@@ -1,4 +1,5 @@
 #include <engine/Shader.h>
+#include <engine/renderer/RenderCommand.h>
 
 #include <iostream>
 #include <sstream>
@@ -39,7 +40,8 @@ static std::string numberedSource(const char* src) {
     return out.str();
 }
 
-Shader::Shader(const std::string& vertSrc, const std::string& fragSrc) {
+Shader::Shader(const std::string& vertSrc, const std::string& fragSrc)
+    : vertexSource_(vertSrc), fragmentSource_(fragSrc) {
     if (vertSrc.empty())
         throw std::invalid_argument("Vertex shader source is null");
     if (fragSrc.empty())
@@ -96,41 +98,32 @@ Shader::~Shader() {
 
 void Shader::bind() const {
     if (program_)
-        glUseProgram(program_);
+        RenderCommand::UseProgram(program_);
 }
 
 void Shader::unbind() const {
-    glUseProgram(0);
+    RenderCommand::UseProgram(0);
 }
 
+// Uniform updates go through RenderCommand so they can be recorded for the render thread
 void Shader::setFloat(const char* name, float value) const {
-    int loc = uniformLocation(name);
-    if (loc >= 0)
-        glUniform1f(loc, value);
+    RenderCommand::SetUniform(program_, name, value);
 }
 
 void Shader::setInt(const char* name, int value) const {
-    int loc = uniformLocation(name);
-    if (loc >= 0)
-        glUniform1i(loc, value);
+    RenderCommand::SetUniform(program_, name, value);
 }
 
 void Shader::setVec3(const char* name, const glm::vec3& value) const {
-    int loc = uniformLocation(name);
-    if (loc >= 0)
-        glUniform3fv(loc, 1, glm::value_ptr(value));
+    RenderCommand::SetUniform(program_, name, value);
 }
 
 void Shader::setVec4(const char* name, const glm::vec4& value) const {
-    int loc = uniformLocation(name);
-    if (loc >= 0)
-        glUniform4fv(loc, 1, glm::value_ptr(value));
+    RenderCommand::SetUniform(program_, name, value);
 }
 
 void Shader::setMat4(const char* name, const glm::mat4& value) const {
-    int loc = uniformLocation(name);
-    if (loc >= 0)
-        glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(value));
+    RenderCommand::SetUniform(program_, name, value);
 }
 
 unsigned int Shader::compileStage(unsigned int type, const char* src) {
@@ -202,10 +195,4 @@ void Shader::checkCompile(unsigned int id, bool isProgram) {
         }
     }
 }
-
-int Shader::uniformLocation(const char* name) const {
-    if (!program_)
-        return -1;
-    return glGetUniformLocation(program_, name);
-}
 } // namespace se
@@ -0,0 +1,45 @@
+#include "engine/StartupTimer.h"
+#include "engine/Log.h"
+#include <algorithm>
+
+namespace se {
+
+StartupTimer::Scope::Scope(StartupTimer& timer, std::string name)
+    : timer_(timer), name_(std::move(name)), start_(Clock::now()) {}
+
+StartupTimer::Scope::~Scope() {
+    timer_.AddPhase(std::move(name_),
+                    std::chrono::duration<float, std::milli>(Clock::now() - start_).count());
+}
+
+void StartupTimer::Start() {
+    start_ = Clock::now();
+    phases_.clear();
+    finished_ = false;
+}
+
+void StartupTimer::AddPhase(std::string name, float milliseconds) {
+    if (finished_)
+        return;
+    phases_.push_back({std::move(name), milliseconds});
+}
+
+void StartupTimer::Finish() {
+    if (finished_)
+        return;
+    finished_ = true;
+
+    float totalMs = std::chrono::duration<float, std::milli>(Clock::now() - start_).count();
+    float accountedMs = 0.0f;
+
+    SE_LOG_INFO("Startup timing:");
+    for (const Phase& phase : phases_) {
+        SE_LOG_INFO("  {:<28} {:8.2f} ms ({:4.1f}%)", phase.Name, phase.Milliseconds,
+                    totalMs > 0.0f ? phase.Milliseconds * 100.0f / totalMs : 0.0f);
+        accountedMs += phase.Milliseconds;
+    }
+    SE_LOG_INFO("  {:<28} {:8.2f} ms", "Other", std::max(totalMs - accountedMs, 0.0f));
+    SE_LOG_INFO("  {:<28} {:8.2f} ms", "Time to first frame", totalMs);
+}
+
+} // namespace se
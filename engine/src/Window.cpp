@@ -3,6 +3,7 @@
 #include "engine/Log.h"
 #include "engine/renderer/GraphicsContext.h"
 #include <GLFW/glfw3.h>
+#include <algorithm>
 #include <stdexcept>
 
 namespace se {
@@ -14,8 +15,11 @@ static void GLFWErrorCallback(int error, const char* description) {
 }
 
 Window::Window(const ApplicationSpec& spec)
-    : Window(spec.WindowWidth, spec.WindowHeight, spec.Name) {
+    : width_(spec.WindowWidth), height_(spec.WindowHeight), title_(spec.Name),
+      headless_(spec.Headless) {
+    Init(spec.WindowWidth, spec.WindowHeight, spec.Name);
     SetVSync(spec.VSync);
+    SetMaxFramesInFlight(spec.MaxFramesInFlight);
 }
 
 Window::Window(uint32_t width, uint32_t height, const std::string& title)
@@ -31,7 +35,38 @@ void Window::OnUpdate() {
     glfwPollEvents();
 }
 
+void Window::MakeContextCurrent() {
+    context_->MakeCurrent();
+}
+
+void Window::ReleaseContext() {
+    context_->ReleaseCurrent();
+}
+
+bool Window::WaitEvents(double timeoutSeconds) {
+    // GLFW doesn't say why it returned; the callbacks and PostWakeup record it instead
+    uint32_t wakeups = wakeups_.load(std::memory_order_acquire);
+    glfwWaitEventsTimeout(timeoutSeconds);
+    return wakeups_.load(std::memory_order_acquire) != wakeups;
+}
+
+void Window::PostWakeup() {
+    wakeups_.fetch_add(1, std::memory_order_release);
+    glfwPostEmptyEvent();
+}
+
+void Window::PushEvent(const Event& event) {
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+    events_.Push(event);
+}
+
 void Window::SetVSync(bool enabled) {
+    if (headless_) {
+        // Nothing is presented, so there is no swap interval to set
+        vsync_ = false;
+        return;
+    }
+
     if (enabled)
         glfwSwapInterval(1);
     else
@@ -52,12 +87,25 @@ void Window::SwapBuffers() {
     context_->SwapBuffers();
 }
 
+void Window::SetMaxFramesInFlight(uint32_t frames) {
+    context_->SetMaxFramesInFlight(frames);
+}
+
+float Window::GetLastFenceWaitMs() const {
+    return context_->GetLastFenceWaitMs();
+}
+
 void Window::Init(uint32_t width, uint32_t height, const std::string& title) {
     width_ = width;
     height_ = height;
     title_ = title;
 
     if (!s_GLFWInitialized) {
+        // Headless runs must not touch X11/Wayland: use GLFW's null platform so the window
+        // handle (and everything that queries it) still works without a display
+        if (headless_)
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
         int success = glfwInit();
         if (!success) {
             throw std::runtime_error("Could not initialize GLFW!");
@@ -75,7 +123,23 @@ void Window::Init(uint32_t width, uint32_t height, const std::string& title) {
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
-    SE_LOG_INFO("Creating window {} ({}, {})", title_, width_, height_);
+    bool surfaceless = false;
+    if (headless_) {
+        // The offscreen target uses renderer_v2 (DSA), which needs GL 4.5
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef SE_HAS_EGL
+        // The GL context is created by GraphicsContext through surfaceless EGL
+        glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+        surfaceless = true;
+#else
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+    }
+
+    SE_LOG_INFO("Creating {}window {} ({}, {})", headless_ ? "headless " : "", title_, width_,
+                height_);
 
     handle_ = glfwCreateWindow((int)width_, (int)height_, title_.c_str(), nullptr, nullptr);
     if (!handle_) {
@@ -84,13 +148,22 @@ void Window::Init(uint32_t width, uint32_t height, const std::string& title) {
     }
 
     // Create graphics context
-    context_ = std::make_unique<GraphicsContext>(handle_);
+    context_ = std::make_unique<GraphicsContext>(handle_, surfaceless);
     context_->Init();
 
     glfwSetWindowUserPointer(handle_, this);
 
-    // Set callbacks
+    // Set callbacks (before ImGui installs its own, which chain to these)
     glfwSetFramebufferSizeCallback(handle_, FramebufferSizeCallback);
+    glfwSetWindowCloseCallback(handle_, WindowCloseCallback);
+    glfwSetKeyCallback(handle_, KeyCallback);
+    glfwSetMouseButtonCallback(handle_, MouseButtonCallback);
+    glfwSetCursorPosCallback(handle_, CursorPosCallback);
+    glfwSetScrollCallback(handle_, ScrollCallback);
+    // No engine events, but they still have to wake an on-demand loop (ImGui text input,
+    // damaged window contents)
+    glfwSetCharCallback(handle_, CharCallback);
+    glfwSetWindowRefreshCallback(handle_, WindowRefreshCallback);
 
     // Set input context
     Input::SetWindow(handle_);
@@ -99,6 +172,10 @@ void Window::Init(uint32_t width, uint32_t height, const std::string& title) {
     int fbWidth, fbHeight;
     glfwGetFramebufferSize(handle_, &fbWidth, &fbHeight);
     glViewport(0, 0, fbWidth, fbHeight);
+
+    // HiDPI: the framebuffer can differ from the requested window size
+    if ((uint32_t)fbWidth != width_ || (uint32_t)fbHeight != height_)
+        events_.Push(Event::WindowResized((uint32_t)fbWidth, (uint32_t)fbHeight));
 }
 
 void Window::Shutdown() {
@@ -108,12 +185,56 @@ void Window::Shutdown() {
     }
 }
 
+static Window* FromHandle(GLFWwindow* window) {
+    return static_cast<Window*>(glfwGetWindowUserPointer(window));
+}
+
 void Window::FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
-    int h = std::max(1, height);
-    int w = std::max(1, width);
+    // Minimized windows report 0x0
+    uint32_t w = (uint32_t)std::max(1, width);
+    uint32_t h = (uint32_t)std::max(1, height);
+
+    // Handled in Application::Run, which may be recording RenderCommands for the render
+    // thread (no GL context on this thread then)
+    if (Window* self = FromHandle(window))
+        self->PushEvent(Event::WindowResized(w, h));
+}
+
+void Window::WindowCloseCallback(GLFWwindow* window) {
+    if (Window* self = FromHandle(window))
+        self->PushEvent(Event::WindowClosed());
+}
 
-    SE_LOG_WARN("Window size callback: ({},{})", w, h);
+void Window::KeyCallback(GLFWwindow* window, int key, int, int action, int mods) {
+    Window* self = FromHandle(window);
+    if (!self || key == GLFW_KEY_UNKNOWN)
+        return;
+    self->PushEvent(
+        Event::KeyChanged(key, action != GLFW_RELEASE, mods, action == GLFW_REPEAT));
+}
+
+void Window::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    if (Window* self = FromHandle(window))
+        self->PushEvent(Event::MouseButtonChanged(button, action == GLFW_PRESS, mods));
+}
+
+void Window::CursorPosCallback(GLFWwindow* window, double xpos, double ypos) {
+    if (Window* self = FromHandle(window))
+        self->PushEvent(Event::MouseMoved((float)xpos, (float)ypos));
+}
+
+void Window::ScrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
+    if (Window* self = FromHandle(window))
+        self->PushEvent(Event::MouseScrolled((float)xoffset, (float)yoffset));
+}
+
+void Window::CharCallback(GLFWwindow* window, unsigned int) {
+    if (Window* self = FromHandle(window))
+        self->wakeups_.fetch_add(1, std::memory_order_relaxed);
+}
 
-    glViewport(0, 0, w, h);
+void Window::WindowRefreshCallback(GLFWwindow* window) {
+    if (Window* self = FromHandle(window))
+        self->wakeups_.fetch_add(1, std::memory_order_relaxed);
 }
-} // namespace se
\ No newline at end of file
+} // namespace se
@@ -1,7 +1,11 @@
 #include "engine/ecs/RenderSystem.h"
+#include "engine/HardwareCounters.h"
 #include "engine/Log.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
 #include "engine/ecs/Components.h"
 #include "engine/ecs/Scene.h"
+#include "engine/renderer/RenderCounters.h"
 #include "engine/renderer/SceneRenderer.h"
 
 namespace se {
@@ -25,11 +29,22 @@ void RenderSystem::Shutdown() {
     initialized_ = false;
 }
 
-void RenderSystem::Render(Scene& scene, const Camera& camera, float aspectRatio) {
+// Scene's only rendering entry point lives here so Scene.cpp stays free of GL
+void Scene::OnRender(const Camera& camera, float aspectRatio, float interpolationAlpha) {
+    RenderSystem::Render(*this, camera, aspectRatio, interpolationAlpha);
+}
+
+void RenderSystem::Render(Scene& scene, const Camera& camera, float aspectRatio,
+                          float interpolationAlpha) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Render);
+    SE_COUNTERS_SCOPE("RenderSystem::Render");
+
     if (!initialized_) {
         SE_LOG_ERROR("RenderSystem not initialized!");
         return;
     }
+    RenderCounters::AddEntities(static_cast<uint32_t>(scene.GetEntityCount()));
 
     // Configure lighting
     SceneRenderer::ClearDirectionalLight();
@@ -67,39 +82,51 @@ void RenderSystem::Render(Scene& scene, const Camera& camera, float aspectRatio)
     int renderedCount = 0;
     int skippedCount = 0;
 
-    // Render each entity
-    for (auto entity : view) {
-        auto& transform = view.get<TransformComponent>(entity);
-        auto& meshRender = view.get<MeshRenderComponent>(entity);
-
-        // Skip if not visible
-        if (!meshRender.IsVisible) {
-            skippedCount++;
-            continue;
+    // Render each entity. Its own counter scope: this walk (GetTransform, component
+    // lookups) is where the cache behaviour of the ECS shows.
+    {
+        SE_COUNTERS_SCOPE("RenderSystem::GatherEntities");
+        for (auto entity : view) {
+            auto& transform = view.get<TransformComponent>(entity);
+            auto& meshRender = view.get<MeshRenderComponent>(entity);
+
+            // Skip if not visible
+            if (!meshRender.IsVisible) {
+                skippedCount++;
+                RenderCounters::AddCulled();
+                continue;
+            }
+
+            // Skip if missing vertex array or material
+            if (!meshRender.VertexArray || !meshRender.Material) {
+                SE_LOG_WARN("Entity missing VertexArray or Material!");
+                skippedCount++;
+                continue;
+            }
+
+            // Debug: Log the first entity's transform
+            static int debugCount = 0;
+            if (debugCount < 1) {
+                auto pos = transform.Position;
+                SE_LOG_INFO("First Entity Transform - Pos: ({}, {}, {})", pos.x, pos.y, pos.z);
+                SE_LOG_INFO("Camera Position: ({}, {}, {})", camera.GetPosition().x,
+                            camera.GetPosition().y, camera.GetPosition().z);
+                SE_LOG_INFO("Projection Matrix: aspectRatio = {}", aspectRatio);
+                debugCount++;
+            }
+
+            glm::mat4 model;
+            const auto* previous = scene.registry_.try_get<PreviousTransformComponent>(entity);
+            if (previous && interpolationAlpha < 1.0f)
+                model = previous->Interpolate(transform, interpolationAlpha);
+            else
+                model = transform.GetTransform();
+
+            // Submit to renderer
+            SceneRenderer::Submit(meshRender.VertexArray, meshRender.Material, model,
+                                  meshRender.CastShadows, meshRender.ReceiveShadows);
+            renderedCount++;
         }
-
-        // Skip if missing vertex array or material
-        if (!meshRender.VertexArray || !meshRender.Material) {
-            SE_LOG_WARN("Entity missing VertexArray or Material!");
-            skippedCount++;
-            continue;
-        }
-
-        // Debug: Log the first entity's transform
-        static int debugCount = 0;
-        if (debugCount < 1) {
-            auto pos = transform.Position;
-            SE_LOG_INFO("First Entity Transform - Pos: ({}, {}, {})", pos.x, pos.y, pos.z);
-            SE_LOG_INFO("Camera Position: ({}, {}, {})", camera.GetPosition().x,
-                        camera.GetPosition().y, camera.GetPosition().z);
-            SE_LOG_INFO("Projection Matrix: aspectRatio = {}", aspectRatio);
-            debugCount++;
-        }
-
-        // Submit to renderer
-        SceneRenderer::Submit(meshRender.VertexArray, meshRender.Material, transform.GetTransform(),
-                              meshRender.CastShadows, meshRender.ReceiveShadows);
-        renderedCount++;
     }
 
     // Always log on first 10 frames
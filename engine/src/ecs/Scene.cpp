@@ -1,7 +1,10 @@
 #include "engine/ecs/Scene.h"
+#include "engine/HardwareCounters.h"
 #include "engine/Log.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
 #include "engine/ecs/Components.h"
-#include "engine/ecs/RenderSystem.h"
+#include "engine/jobs/JobSystem.h"
 
 namespace se {
 
@@ -53,6 +56,9 @@ Entity Scene::FindEntityByName(const std::string& name) {
 }
 
 void Scene::OnUpdate(float deltaTime) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Ecs);
+
     // Systems can be implemented here
     // Example: Physics system, Animation system, etc.
 
@@ -60,8 +66,38 @@ void Scene::OnUpdate(float deltaTime) {
     (void)deltaTime;
 }
 
-void Scene::OnRender(const Camera& camera, float aspectRatio) {
-    RenderSystem::Render(*this, camera, aspectRatio);
+void Scene::OnFixedUpdate(float fixedDeltaTime) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Ecs);
+    SE_COUNTERS_SCOPE("Scene::OnFixedUpdate");
+
+    // Snapshot transforms for render interpolation
+    auto view = registry_.view<TransformComponent>();
+    for (auto entity : view) {
+        registry_.emplace_or_replace<PreviousTransformComponent>(
+            entity, view.get<TransformComponent>(entity));
+    }
+
+    (void)fixedDeltaTime;
+}
+
+void Scene::Step(float fixedDeltaTime, const SystemFn& system) {
+    OnFixedUpdate(fixedDeltaTime);
+    if (system)
+        system(*this, fixedDeltaTime);
+    OnUpdate(fixedDeltaTime);
+}
+
+void Scene::StepParallel(std::span<Scene* const> scenes, float fixedDeltaTime, uint32_t steps,
+                         JobSystem& jobs, const SystemFn& system) {
+    // One scene per batch: scenes are coarse, uneven units of work and stealing balances them
+    jobs.ParallelFor(static_cast<uint32_t>(scenes.size()), 1,
+                     [&](uint32_t begin, uint32_t end) {
+                         for (uint32_t i = begin; i < end; ++i) {
+                             for (uint32_t step = 0; step < steps; ++step)
+                                 scenes[i]->Step(fixedDeltaTime, system);
+                         }
+                     });
 }
 
 void Scene::Clear() {
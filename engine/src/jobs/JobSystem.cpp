@@ -0,0 +1,210 @@
+#include "engine/jobs/JobSystem.h"
+#include "engine/HardwareCounters.h"
+#include "engine/Log.h"
+#include "engine/Profiler.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+namespace se {
+
+JobSystem* JobSystem::s_Instance = nullptr;
+
+// Which queue the current thread owns (workers only)
+static thread_local const JobSystem* tls_Owner = nullptr;
+static thread_local uint32_t tls_QueueIndex = 0;
+
+JobSystem::JobSystem(const JobSystemSpec& spec) {
+    if (s_Instance) {
+        SE_LOG_WARN("JobSystem already exists; JobSystem::Get() keeps the first one");
+    } else {
+        s_Instance = this;
+    }
+
+    uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t workerCount = spec.WorkerCount;
+    if (workerCount == 0)
+        workerCount = std::max(1u, hardwareThreads - 1);
+
+    for (uint32_t i = 0; i < workerCount + 1; ++i)
+        queues_.push_back(std::make_unique<WorkQueue>());
+
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&JobSystem::WorkerLoop, this, i);
+
+#ifdef __linux__
+        std::string name = "se-worker-" + std::to_string(i);
+        pthread_setname_np(workers_.back().native_handle(), name.substr(0, 15).c_str());
+
+        if (spec.PinWorkers) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET((spec.FirstCore + i) % hardwareThreads, &cpus);
+            if (pthread_setaffinity_np(workers_.back().native_handle(), sizeof(cpus), &cpus) != 0)
+                SE_LOG_WARN("Failed to pin job worker {} to a core", i);
+        }
+#else
+        if (spec.PinWorkers && i == 0)
+            SE_LOG_WARN("Job worker pinning is only supported on Linux");
+#endif
+    }
+
+    SE_LOG_INFO("Job system started with {} worker(s){}", workerCount,
+                spec.PinWorkers ? " (pinned)" : "");
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wakeCondition_.notify_all();
+
+    // Workers drain the queues before exiting. Whatever a last job scheduled after they
+    // left runs here, so no counter is left pending.
+    for (auto& worker : workers_)
+        worker.join();
+    uint32_t injectionQueue = static_cast<uint32_t>(queues_.size() - 1);
+    while (TryRunJob(injectionQueue)) {
+    }
+
+    if (s_Instance == this)
+        s_Instance = nullptr;
+}
+
+void JobSystem::Schedule(Job job, JobCounter* counter) {
+    if (counter)
+        counter->Pending.fetch_add(1, std::memory_order_relaxed);
+
+    // Counted before it becomes visible, so a worker that pops it right away can't take
+    // the count below zero
+    queuedJobs_.fetch_add(1, std::memory_order_release);
+    WorkQueue& queue = *queues_[CurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Jobs.push_back({std::move(job), counter});
+    }
+
+    // Taking the lock orders this with a worker that is about to sleep (no lost wakeup)
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    wakeCondition_.notify_one();
+}
+
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, const RangeJob& body) {
+    if (count == 0)
+        return;
+
+    batchSize = std::max(1u, batchSize);
+    uint32_t batchCount = (count + batchSize - 1) / batchSize;
+    if (batchCount == 1) {
+        body(0, count);
+        return;
+    }
+
+    // The caller takes the first batch, the rest go to the pool
+    JobCounter counter;
+    for (uint32_t batch = 1; batch < batchCount; ++batch) {
+        uint32_t begin = batch * batchSize;
+        uint32_t end = std::min(begin + batchSize, count);
+        Schedule([&body, begin, end]() { body(begin, end); }, &counter);
+    }
+
+    body(0, std::min(batchSize, count));
+    WaitForCounter(counter);
+}
+
+void JobSystem::WaitForCounter(JobCounter& counter) {
+    uint32_t queueIndex = CurrentQueueIndex();
+    while (!counter.IsDone()) {
+        if (!TryRunJob(queueIndex))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::WorkerLoop(uint32_t workerIndex) {
+    tls_Owner = this;
+    tls_QueueIndex = workerIndex;
+    Profiler::SetThreadName("Worker " + std::to_string(workerIndex));
+
+    while (true) {
+        if (TryRunJob(workerIndex))
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wakeCondition_.wait(lock, [this]() {
+            return stopping_.load() || queuedJobs_.load(std::memory_order_acquire) > 0;
+        });
+        // Queued jobs still run after stop: dropping them would strand their counters
+        if (stopping_ && queuedJobs_.load(std::memory_order_acquire) == 0)
+            break;
+    }
+
+    tls_Owner = nullptr;
+}
+
+bool JobSystem::TryRunJob(uint32_t queueIndex) {
+    QueuedJob job;
+    if (!PopOwn(queueIndex, job) && !Steal(queueIndex, job))
+        return false;
+
+    queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+bool JobSystem::PopOwn(uint32_t queueIndex, QueuedJob& job) {
+    WorkQueue& queue = *queues_[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.Mutex);
+    if (queue.Jobs.empty())
+        return false;
+
+    // Newest first: its data is most likely still in cache
+    job = std::move(queue.Jobs.back());
+    queue.Jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::Steal(uint32_t thiefIndex, QueuedJob& job) {
+    uint32_t queueCount = static_cast<uint32_t>(queues_.size());
+    for (uint32_t offset = 1; offset < queueCount; ++offset) {
+        WorkQueue& victim = *queues_[(thiefIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.Mutex);
+        if (victim.Jobs.empty())
+            continue;
+
+        // Oldest first: usually the biggest chunk of remaining work
+        job = std::move(victim.Jobs.front());
+        victim.Jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(QueuedJob& job) {
+    // Workers open their counters lazily: they start before counters can be enabled
+    if (tls_Owner == this)
+        HardwareCounters::AttachThread(true);
+
+    SE_PROFILE_SCOPE("Job");
+    try {
+        job.Function();
+    } catch (const std::exception& e) {
+        SE_LOG_ERROR("Unhandled exception in job: {}", e.what());
+    }
+
+    if (job.Counter)
+        job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+}
+
+uint32_t JobSystem::CurrentQueueIndex() const {
+    // Non-worker threads share the injection queue
+    return tls_Owner == this ? tls_QueueIndex : static_cast<uint32_t>(queues_.size() - 1);
+}
+
+} // namespace se
@@ -0,0 +1,279 @@
+#include "engine/memory/AllocationTracker.h"
+#include "engine/Log.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace se {
+
+namespace {
+
+// Constant-initialized, so they are usable by allocations made before main()
+std::array<std::atomic<uint64_t>, kAllocTagCount> s_Counts{};
+std::array<std::atomic<uint64_t>, kAllocTagCount> s_Bytes{};
+std::atomic<uint64_t> s_Frees{0};
+std::atomic<uint64_t> s_Violations{0};
+std::atomic<uint64_t> s_Frame{0};
+std::atomic<ZeroAllocMode> s_ZeroAllocMode{ZeroAllocMode::Report};
+
+// Distinct regions that allocated this frame, for the end-of-frame report
+constexpr uint32_t kMaxReportedRegions = 8;
+std::array<std::atomic<const char*>, kMaxReportedRegions> s_ViolatingRegions{};
+
+// Frames whose violations get logged; after that they are only counted
+constexpr uint32_t kMaxReportedFrames = 16;
+uint32_t s_ReportedFrames = 0;
+
+// Main thread only (EndFrame)
+AllocationFrameStats s_Totals{};
+AllocationFrameStats s_LastFrame{};
+
+thread_local AllocTag t_Tag = AllocTag::Untagged;
+thread_local const char* t_ZeroAllocRegion = nullptr;
+
+AllocationFrameStats Snapshot() {
+    AllocationFrameStats stats;
+    for (size_t i = 0; i < kAllocTagCount; ++i) {
+        stats.Tags[i].Count = s_Counts[i].load(std::memory_order_relaxed);
+        stats.Tags[i].Bytes = s_Bytes[i].load(std::memory_order_relaxed);
+    }
+    stats.Frees = s_Frees.load(std::memory_order_relaxed);
+    stats.ZeroAllocViolations = s_Violations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+[[maybe_unused]] void RecordViolation(const char* region) {
+    if (s_ZeroAllocMode.load(std::memory_order_relaxed) == ZeroAllocMode::Abort) {
+        // No logging here: it would allocate again
+        std::fputs("Allocation inside zero-alloc scope: ", stderr);
+        std::fputs(region, stderr);
+        std::fputc('\n', stderr);
+        std::abort();
+    }
+
+    s_Violations.fetch_add(1, std::memory_order_relaxed);
+    for (auto& slot : s_ViolatingRegions) {
+        const char* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, region) || expected == region)
+            break;
+    }
+}
+
+[[maybe_unused]] void RecordAllocation(size_t size) noexcept {
+    size_t tag = static_cast<size_t>(t_Tag);
+    s_Counts[tag].fetch_add(1, std::memory_order_relaxed);
+    s_Bytes[tag].fetch_add(size, std::memory_order_relaxed);
+
+    if (t_ZeroAllocRegion && s_Frame.load(std::memory_order_relaxed) >=
+                                 AllocationTracker::kWarmupFrames &&
+        s_ZeroAllocMode.load(std::memory_order_relaxed) != ZeroAllocMode::Off) {
+        RecordViolation(t_ZeroAllocRegion);
+    }
+}
+
+} // namespace
+
+AllocationCounters AllocationFrameStats::Total() const {
+    AllocationCounters total;
+    for (const AllocationCounters& tag : Tags) {
+        total.Count += tag.Count;
+        total.Bytes += tag.Bytes;
+    }
+    return total;
+}
+
+void AllocationTracker::SetZeroAllocMode(ZeroAllocMode mode) {
+    s_ZeroAllocMode.store(mode);
+}
+
+ZeroAllocMode AllocationTracker::GetZeroAllocMode() {
+    return s_ZeroAllocMode.load();
+}
+
+void AllocationTracker::EndFrame() {
+    AllocationFrameStats totals = Snapshot();
+
+    AllocationFrameStats frame;
+    frame.Frame = s_Frame.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kAllocTagCount; ++i) {
+        frame.Tags[i].Count = totals.Tags[i].Count - s_Totals.Tags[i].Count;
+        frame.Tags[i].Bytes = totals.Tags[i].Bytes - s_Totals.Tags[i].Bytes;
+    }
+    frame.Frees = totals.Frees - s_Totals.Frees;
+    frame.ZeroAllocViolations = totals.ZeroAllocViolations - s_Totals.ZeroAllocViolations;
+    s_Totals = totals;
+    s_LastFrame = frame;
+
+    if (frame.ZeroAllocViolations > 0 && s_ReportedFrames < kMaxReportedFrames) {
+        s_ReportedFrames++;
+        for (auto& slot : s_ViolatingRegions) {
+            const char* region = slot.exchange(nullptr);
+            if (region)
+                SE_LOG_WARN("Frame {}: allocation(s) inside zero-alloc scope '{}'", frame.Frame,
+                            region);
+        }
+        SE_LOG_WARN("Frame {}: {} allocation(s) in zero-alloc scopes{}", frame.Frame,
+                    frame.ZeroAllocViolations,
+                    s_ReportedFrames == kMaxReportedFrames ? " (further reports muted)" : "");
+    } else {
+        for (auto& slot : s_ViolatingRegions)
+            slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    s_Frame.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationFrameStats AllocationTracker::GetLastFrame() {
+    return s_LastFrame;
+}
+
+AllocationFrameStats AllocationTracker::GetTotals() {
+    AllocationFrameStats totals = Snapshot();
+    totals.Frame = s_Frame.load(std::memory_order_relaxed);
+    return totals;
+}
+
+const char* AllocationTracker::GetTagName(AllocTag tag) {
+    switch (tag) {
+    case AllocTag::Untagged:
+        return "Untagged";
+    case AllocTag::Render:
+        return "Render";
+    case AllocTag::Ecs:
+        return "ECS";
+    case AllocTag::Resources:
+        return "Resources";
+    case AllocTag::UI:
+        return "UI";
+    case AllocTag::Log:
+        return "Log";
+    default:
+        return "Unknown";
+    }
+}
+
+AllocTag AllocationTracker::SetThreadTag(AllocTag tag) noexcept {
+    AllocTag previous = t_Tag;
+    t_Tag = tag;
+    return previous;
+}
+
+const char* AllocationTracker::SetZeroAllocRegion(const char* name) noexcept {
+    const char* previous = t_ZeroAllocRegion;
+    t_ZeroAllocRegion = name;
+    return previous;
+}
+
+} // namespace se
+
+#ifdef SE_TRACK_ALLOCATIONS
+
+// Replacement global allocation functions. They live in this translation unit so they are
+// linked whenever Application (which calls EndFrame) is.
+
+namespace {
+
+void* TrackedAllocate(std::size_t size, std::size_t alignment) noexcept {
+    se::RecordAllocation(size);
+    if (size == 0)
+        size = 1;
+    if (alignment <= alignof(std::max_align_t))
+        return std::malloc(size);
+#    if defined(_MSC_VER)
+    return _aligned_malloc(size, alignment);
+#    else
+    void* memory = nullptr;
+    return posix_memalign(&memory, alignment, size) == 0 ? memory : nullptr;
+#    endif
+}
+
+void* TrackedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+    void* memory = TrackedAllocate(size, alignment);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void TrackedFree(void* memory, std::size_t alignment) noexcept {
+    if (!memory)
+        return;
+    se::s_Frees.fetch_add(1, std::memory_order_relaxed);
+#    if defined(_MSC_VER)
+    if (alignment > alignof(std::max_align_t)) {
+        _aligned_free(memory);
+        return;
+    }
+#    endif
+    (void)alignment;
+    std::free(memory);
+}
+
+constexpr std::size_t kDefaultAlignment = alignof(std::max_align_t);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return TrackedAllocateOrThrow(size, kDefaultAlignment);
+}
+void* operator new[](std::size_t size) {
+    return TrackedAllocateOrThrow(size, kDefaultAlignment);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAllocate(size, kDefaultAlignment);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAllocate(size, kDefaultAlignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return TrackedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return TrackedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return TrackedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return TrackedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept {
+    TrackedFree(memory, kDefaultAlignment);
+}
+void operator delete[](void* memory) noexcept {
+    TrackedFree(memory, kDefaultAlignment);
+}
+void operator delete(void* memory, std::size_t) noexcept {
+    TrackedFree(memory, kDefaultAlignment);
+}
+void operator delete[](void* memory, std::size_t) noexcept {
+    TrackedFree(memory, kDefaultAlignment);
+}
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    TrackedFree(memory, kDefaultAlignment);
+}
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    TrackedFree(memory, kDefaultAlignment);
+}
+void operator delete(void* memory, std::align_val_t alignment) noexcept {
+    TrackedFree(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* memory, std::align_val_t alignment) noexcept {
+    TrackedFree(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept {
+    TrackedFree(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept {
+    TrackedFree(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    TrackedFree(memory, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    TrackedFree(memory, static_cast<std::size_t>(alignment));
+}
+
+#endif
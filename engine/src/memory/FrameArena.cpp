@@ -0,0 +1,111 @@
+#include "engine/memory/FrameArena.h"
+#include "engine/Log.h"
+#include <algorithm>
+
+namespace se {
+
+FrameArena* FrameArena::s_Instance = nullptr;
+
+static size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+FrameArena::FrameArena(size_t bytesPerFrame, uint32_t frameCount)
+    : frameCount_(std::clamp(frameCount, 1u, kMaxFrames)) {
+    bytesPerFrame = AlignUp(std::max<size_t>(bytesPerFrame, 4096), 4096);
+    for (uint32_t i = 0; i < frameCount_; ++i) {
+        blocks_[i].Data = static_cast<std::byte*>(
+            ::operator new(bytesPerFrame, std::align_val_t(alignof(std::max_align_t))));
+        blocks_[i].Capacity = bytesPerFrame;
+    }
+
+    if (s_Instance) {
+        SE_LOG_WARN("FrameArena already exists; FrameArena::Get() keeps the first one");
+        return;
+    }
+    s_Instance = this;
+}
+
+FrameArena::~FrameArena() {
+    for (uint32_t i = 0; i < frameCount_; ++i) {
+        Block& block = blocks_[i];
+        for (const Overflow& overflow : block.Overflows)
+            ::operator delete(overflow.Pointer, std::align_val_t(overflow.Alignment));
+        ::operator delete(block.Data, std::align_val_t(alignof(std::max_align_t)));
+    }
+
+    if (s_Instance == this)
+        s_Instance = nullptr;
+}
+
+FrameArena* FrameArena::Get() {
+    return s_Instance;
+}
+
+void FrameArena::BeginFrame() {
+    const Block& finished = blocks_[current_];
+    peakBytes_ = std::max(peakBytes_, finished.Offset.load() + finished.OverflowBytes);
+
+    current_ = (current_ + 1) % frameCount_;
+    Rewind(blocks_[current_]);
+}
+
+void FrameArena::Rewind(Block& block) {
+    if (!block.Overflows.empty()) {
+        // Grow so that a frame like the last one fits entirely in the block
+        size_t needed = block.Offset.load() + block.OverflowBytes;
+        size_t capacity = AlignUp(std::max(needed + needed / 4, block.Capacity * 2), 4096);
+
+        for (const Overflow& overflow : block.Overflows)
+            ::operator delete(overflow.Pointer, std::align_val_t(overflow.Alignment));
+        block.Overflows.clear();
+        block.OverflowBytes = 0;
+
+        ::operator delete(block.Data, std::align_val_t(alignof(std::max_align_t)));
+        block.Data = static_cast<std::byte*>(
+            ::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+        block.Capacity = capacity;
+
+        SE_LOG_INFO("FrameArena block grown to {} KiB", capacity / 1024);
+    }
+    block.Offset.store(0);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    Block& block = blocks_[current_];
+    if (size == 0)
+        size = 1;
+
+    size_t offset = block.Offset.load(std::memory_order_relaxed);
+    for (;;) {
+        size_t aligned = AlignUp(offset, alignment);
+        if (aligned + size > block.Capacity)
+            return AllocateOverflow(block, size, alignment);
+        if (block.Offset.compare_exchange_weak(offset, aligned + size,
+                                               std::memory_order_relaxed))
+            return block.Data + aligned;
+    }
+}
+
+void* FrameArena::AllocateOverflow(Block& block, size_t size, size_t alignment) {
+    alignment = std::max(alignment, alignof(std::max_align_t));
+    void* pointer = ::operator new(size, std::align_val_t(alignment));
+
+    std::lock_guard<std::mutex> lock(overflowMutex_);
+    block.Overflows.push_back({pointer, alignment});
+    block.OverflowBytes += size;
+    return pointer;
+}
+
+FrameArenaStats FrameArena::GetStats() const {
+    const Block& block = blocks_[current_];
+
+    FrameArenaStats stats;
+    stats.UsedBytes = block.Offset.load();
+    stats.CapacityBytes = block.Capacity;
+    stats.OverflowBytes = block.OverflowBytes;
+    stats.PeakBytes = std::max(peakBytes_, stats.UsedBytes + stats.OverflowBytes);
+    return stats;
+}
+
+} // namespace se
@@ -1,5 +1,8 @@
 #include "engine/resources/MaterialManager.h"
 #include "engine/Log.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
+#include "engine/jobs/JobSystem.h"
 
 namespace se {
 std::shared_ptr<Material> MaterialManager::defaultMaterial_;
@@ -8,6 +11,9 @@ std::unordered_map<std::string, std::shared_ptr<Shader>> MaterialManager::shader
 bool MaterialManager::initialized_ = false;
 
 void MaterialManager::Init() {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
     if (initialized_) {
         SE_LOG_WARN("MaterialManager already initialized");
         return;
@@ -15,17 +21,24 @@ void MaterialManager::Init() {
 
     SE_LOG_INFO("Initializing MaterialManager");
 
-    CreateDefaultShader();
+    // The default shader is compiled on first use; apps with their own shaders never pay
+    // for it at startup
+    SE_LOG_INFO("MaterialManager initialized successfully");
+    initialized_ = true;
+}
 
-    if (!defaultShader_) {
-        SE_LOG_ERROR("Failed to create default shader!");
-        throw std::runtime_error("Failed to create default shader");
+bool MaterialManager::EnsureDefaultMaterial() {
+    if (defaultMaterial_)
+        return true;
+
+    try {
+        CreateDefaultShader();
+    } catch (const std::exception&) {
+        return false;
     }
 
     defaultMaterial_ = std::make_shared<Material>(defaultShader_);
-
-    SE_LOG_INFO("MaterialManager initialized successfully");
-    initialized_ = true;
+    return true;
 }
 
 void MaterialManager::Shutdown() {
@@ -47,7 +60,7 @@ std::shared_ptr<Material> MaterialManager::GetDefaultMaterial() {
         return nullptr;
     }
 
-    if (!defaultMaterial_) {
+    if (!EnsureDefaultMaterial()) {
         SE_LOG_ERROR("Default material is null!");
         return nullptr;
     }
@@ -56,6 +69,9 @@ std::shared_ptr<Material> MaterialManager::GetDefaultMaterial() {
 }
 
 std::shared_ptr<Material> MaterialManager::CreateMaterial(std::shared_ptr<Shader> shader) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
     if (!shader) {
         SE_LOG_WARN("Creating material with null shader, using default");
         return GetDefaultMaterial();
@@ -87,11 +103,85 @@ std::shared_ptr<Shader> MaterialManager::GetShader(const std::string& name,
         return shader;
     } catch (const std::exception& e) {
         SE_LOG_ERROR("Failed to load shader '{}': {}", name, e.what());
+        EnsureDefaultMaterial();
         return defaultShader_;
     }
 }
 
+void MaterialManager::PreloadShaders(const std::vector<ShaderSourceFiles>& shaders) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
+    if (!initialized_) {
+        SE_LOG_ERROR("MaterialManager not initialized!");
+        return;
+    }
+
+    struct LoadedSources {
+        std::string Vertex;
+        std::string Fragment;
+        std::string Error;
+    };
+    std::vector<LoadedSources> sources(shaders.size());
+
+    auto read = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            if (shaderCache_.count(shaders[i].Name))
+                continue;
+            try {
+                sources[i].Vertex = readFileToString(shaders[i].VertexPath);
+                sources[i].Fragment = readFileToString(shaders[i].FragmentPath);
+            } catch (const std::exception& e) {
+                sources[i].Error = e.what();
+            }
+        }
+    };
+
+    if (JobSystem* jobs = JobSystem::Get())
+        jobs->ParallelFor(static_cast<uint32_t>(shaders.size()), 1, read);
+    else
+        read(0, static_cast<uint32_t>(shaders.size()));
+
+    // Compiling needs the GL context, so it stays on this thread
+    for (size_t i = 0; i < shaders.size(); ++i) {
+        const std::string& name = shaders[i].Name;
+        if (shaderCache_.count(name))
+            continue;
+
+        try {
+            if (!sources[i].Error.empty())
+                throw std::runtime_error(sources[i].Error);
+            shaderCache_[name] = std::make_shared<Shader>(sources[i].Vertex, sources[i].Fragment);
+            SE_LOG_INFO("Loaded and cached shader: {}", name);
+        } catch (const std::exception& e) {
+            SE_LOG_ERROR("Failed to load shader '{}': {}", name, e.what());
+        }
+    }
+}
+
+void MaterialManager::GetShaderAsync(const std::string& name,
+                                     const std::filesystem::path& vertPath,
+                                     const std::filesystem::path& fragPath,
+                                     std::function<void(std::shared_ptr<Shader>)> onReady,
+                                     TaskPriority priority) {
+    MainThreadQueue* queue = MainThreadQueue::Get();
+    if (shaderCache_.count(name) || !queue) {
+        onReady(GetShader(name, vertPath, fragPath));
+        return;
+    }
+
+    queue->Enqueue(
+        [name, vertPath, fragPath, onReady = std::move(onReady)]() {
+            onReady(GetShader(name, vertPath, fragPath));
+            return TaskStatus::Done;
+        },
+        priority);
+}
+
 void MaterialManager::CreateDefaultShader() {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
     SE_LOG_INFO("Creating default shader...");
 
     // Simple default vertex shader
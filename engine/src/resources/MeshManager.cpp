@@ -1,7 +1,11 @@
 #include "engine/resources/MeshManager.h"
 #include "engine/Log.h"
+#include "engine/Profiler.h"
+#include "engine/memory/AllocationTracker.h"
 #include "engine/MeshFactory.h"
+#include "engine/jobs/JobSystem.h"
 #include "engine/renderer/Buffer.h"
+#include <algorithm>
 
 namespace se {
 std::unordered_map<PrimitiveMeshType, std::shared_ptr<VertexArray>> MeshManager::primitiveCache_;
@@ -28,6 +32,9 @@ void MeshManager::Shutdown() {
 }
 
 std::shared_ptr<VertexArray> MeshManager::CreateVertexArrayFromMesh(const Mesh& mesh) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
     // COPIE os dados para garantir que eles persistem
     std::vector<float> vertices = mesh.getVertices();
     std::vector<unsigned int> indices = mesh.getIndices();
@@ -58,6 +65,9 @@ std::shared_ptr<VertexArray> MeshManager::CreateVertexArrayFromMesh(const Mesh&
 }
 
 std::shared_ptr<VertexArray> MeshManager::GetPrimitive(PrimitiveMeshType type) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
     if (!initialized_) {
         SE_LOG_ERROR("MeshManager not initialized!");
         return nullptr;
@@ -85,7 +95,32 @@ std::shared_ptr<VertexArray> MeshManager::GetPrimitive(PrimitiveMeshType type) {
     return primitive;
 }
 
+void MeshManager::GetPrimitiveAsync(PrimitiveMeshType type,
+                                    std::function<void(std::shared_ptr<VertexArray>)> onReady,
+                                    TaskPriority priority) {
+    auto it = primitiveCache_.find(type);
+    MainThreadQueue* queue = MainThreadQueue::Get();
+    if (it != primitiveCache_.end() || !queue) {
+        onReady(GetPrimitive(type));
+        return;
+    }
+
+    queue->Enqueue(
+        [type, onReady = std::move(onReady)]() {
+            onReady(GetPrimitive(type));
+            return TaskStatus::Done;
+        },
+        priority);
+}
+
 std::shared_ptr<VertexArray> MeshManager::CreatePrimitive(PrimitiveMeshType type) {
+    return CreateVertexArrayFromMesh(GeneratePrimitiveMesh(type));
+}
+
+Mesh MeshManager::GeneratePrimitiveMesh(PrimitiveMeshType type) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
     Mesh mesh;
 
     switch (type) {
@@ -119,7 +154,42 @@ std::shared_ptr<VertexArray> MeshManager::CreatePrimitive(PrimitiveMeshType type
             break;
     }
 
-    return CreateVertexArrayFromMesh(mesh);
+    return mesh;
+}
+
+void MeshManager::PreloadPrimitives(const std::vector<PrimitiveMeshType>& types) {
+    SE_PROFILE_FUNCTION();
+    SE_ALLOC_TAG(Resources);
+
+    if (!initialized_) {
+        SE_LOG_ERROR("MeshManager not initialized!");
+        return;
+    }
+
+    std::vector<PrimitiveMeshType> missing;
+    for (PrimitiveMeshType type : types) {
+        if (!primitiveCache_.count(type) &&
+            std::find(missing.begin(), missing.end(), type) == missing.end())
+            missing.push_back(type);
+    }
+    if (missing.empty())
+        return;
+
+    std::vector<Mesh> meshes(missing.size());
+    auto generate = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i)
+            meshes[i] = GeneratePrimitiveMesh(missing[i]);
+    };
+
+    if (JobSystem* jobs = JobSystem::Get())
+        jobs->ParallelFor(static_cast<uint32_t>(missing.size()), 1, generate);
+    else
+        generate(0, static_cast<uint32_t>(missing.size()));
+
+    for (size_t i = 0; i < missing.size(); ++i)
+        primitiveCache_[missing[i]] = CreateVertexArrayFromMesh(meshes[i]);
+
+    SE_LOG_INFO("Preloaded {} primitive mesh(es)", missing.size());
 }
 
 void MeshManager::ClearCache() {